@@ -1,10 +1,252 @@
 #pragma once
 #include "Arduino.h"
 #include "LittleFS.h"
+#include <type_traits>
+
+#define DEPO_MAX_DERINLIK 8        // dolas() ile inilebilecek en fazla klasör derinliği
+#define DEPO_BUYUK_DOSYA 3         // kullanım ağacında her klasör için tutulan en büyük dosya sayısı
+#define DEPO_KULLANIM_MAX_DIZIN 12 // kullanim_listele() için ayrılan klasör kaydı sayısı
+#define DEPO_TAMPON 256            // blok blok okuyan fonksiyonların yığın tamponu (bayt)
+
+#ifndef DEPO_KILITLI
+#define DEPO_KILITLI 0             // 1: ESP32'de dosya bazlı okuyucu/yazıcı kilitleri açılır (FreeRTOS gerekir)
+#endif
+#define DEPO_KILIT_SAYISI 8        // yolların dağıtıldığı kilit sayısı
+
+#define DEPO_ARA_MAX 64             // agacta_ara() ile aranabilecek en uzun metin
+#define DEPO_SIRALA_TAMPON 2048    // sirala() koşu üretimi için ayrılan RAM (bayt)
+#define DEPO_SIRALA_KOL 4          // sirala() birleştirmesinde aynı anda açılan koşu sayısı
+#define DEPO_OZET_SAYISI 8         // içerik özeti (CRC) tutulan en fazla dosya sayısı
+#define DEPO_YAPI_IMZA 0x31595044UL // "DPY1", başlıklı yapı dosyalarının imzası
+#define DEPO_ARSIV_IMZA 0x31415044UL // "DPA1", arsivle() ile üretilen arşivlerin imzası
+#define DEPO_ARSIV_TAMPON 512     // arşivden çıkarmada kullanılan yığın tamponu (bayt)
+#define DEPO_SABIT_SAYISI 4        // RAM'e sabitlenebilecek en fazla dosya sayısı
+#define DEPO_SABIT_SURE 10000UL    // kirli sabit dosyanın flash'a aktarılmadan önce bekleyebileceği süre (ms)
+#define DEPO_SABIT_ESIK 64         // bu kadar RAM yazmasından sonra sabit dosya hemen aktarılır
+#define DEPO_BLOOM_SAYISI 4        // Bloom süzgeci açılabilecek en fazla dosya sayısı
+#define DEPO_BLOOM_MAX_BAYT 4096   // bir süzgecin bit dizisi için üst sınır; yeniden kurulurken RAM'de tutulur
+#define DEPO_BLOOM_IMZA 0x31425044UL // "DPB1", .blm süzgeç dosyalarının imzası
+#define DEPO_AKTAR_TAMPON 512     // aktar() ile hedefe parça parça yazılırken kullanılan yığın tamponu (bayt)
+#define DEPO_GUNLUK_SAYISI 2       // günlüklü satır düzenleme açılabilecek en fazla dosya sayısı
+#define DEPO_GUNLUK_ESIK 2048      // günlük bu boyuta ulaşınca tabana işlenir (bayt); kayıtlar RAM'de de tutulur
+#define DEPO_SATIR_TAMPON 128     // satirlar() yineleyicisinin okuma tamponu; daha uzun satırlar parça parça gelir
+#define DEPO_SATIR_YOK 0xFFFFFFFFUL // oku/sil aralığında "son satır verilmedi"
+#define DEPO_DOSYA_SONU 0xFFFFFFFEUL // aralığın son satırı olarak dosyanın sonuna kadar
+
+#if DEPO_KILITLI && !defined(ESP32)
+#error "DEPO_KILITLI yalnizca ESP32 (FreeRTOS) uzerinde kullanilabilir"
+#endif
+
+struct dosya_kullanim
+{
+    String yol;
+    uint32_t bayt = 0;
+};
+
+struct dizin_kullanim
+{
+    String yol;
+    int16_t ust = -1;         // üst klasörün dizideki sırası, kök için -1
+    uint8_t derinlik = 0;     // kök 0
+    uint32_t bayt = 0;        // alt klasörler dahil toplam bayt
+    uint16_t dosya_sayisi = 0; // alt klasörler dahil dosya sayısı
+    dosya_kullanim en_buyukler[DEPO_BUYUK_DOSYA];
+};
+
+#if DEPO_KILITLI
+class yol_kilidi
+{
+public:
+    yol_kilidi(const char *isim, bool yazma);
+    yol_kilidi(const char *kaynak, const char *hedef, bool kaynakYazma = false);
+    ~yol_kilidi();
+    bool tamam() const { return _tamam; }
+    static void kritik_gir();
+    static void kritik_cik();
+    static bool okuyor(const char *isim);
+
+private:
+    int8_t _okuma = -1;
+    int8_t _yazma = -1;
+    int8_t _yazma2 = -1;
+    bool _tamam = true;
+    bool al(uint8_t no, bool yazma);
+};
+#else
+class yol_kilidi
+{
+public:
+    yol_kilidi(const char *, bool) {}
+    yol_kilidi(const char *, const char *, bool = false) {}
+    bool tamam() const { return true; }
+    static void kritik_gir() {}
+    static void kritik_cik() {}
+    static bool okuyor(const char *) { return false; }
+};
+#endif
+
+struct depo_yapi_basligi
+{
+    uint32_t imza;
+    uint16_t surum;
+    uint16_t boyut;
+    uint32_t crc;
+};
+
+struct sirala_rapor
+{
+    uint32_t satir = 0;        // okunan satır sayısı
+    uint16_t kosu = 0;         // ilk geçişte üretilen sıralı koşu sayısı
+    uint8_t gecis = 0;         // veri üzerinden yapılan tam geçiş sayısı
+    uint32_t yazilan_bayt = 0; // geçici dosyalar dahil flash'a yazılan bayt
+};
+
+enum gunluk_turu : char
+{
+    GUNLUK_DEGISTIR = 'D', // satir_degistir
+    GUNLUK_EKLE = 'E',     // satir_ekle
+    GUNLUK_SIL = 'S'       // satir_sil
+};
+
+enum ara_modu : uint8_t
+{
+    ARA_ICERIR, // satırın herhangi bir yerinde geçen
+    ARA_BASLAR  // satır başında geçen
+};
+
+struct arsiv_rapor
+{
+    uint16_t dosya = 0;   // arşivlenen/çıkarılan dosya sayısı
+    uint16_t dizin = 0;   // arşivlenen/oluşturulan klasör sayısı
+    uint32_t bayt = 0;    // dosya içeriklerinin toplamı
+    uint16_t atlanan = 0; // açılamadığı, yolu çok uzun veya (çıkarmada) .jrn/.blm olduğu için atlanan girdi
+    uint16_t hata = 0;    // CRC tutmayan, yazılamayan veya yerine konamayan dosya/arşiv
+};
+
+struct ozet_istatistik
+{
+    uint32_t yazilan = 0;         // flash'a yazılan yaz/degistir/yedekle çağrısı
+    uint32_t atlanan = 0;         // içerik aynı olduğu için atlanan çağrı
+    uint32_t ozetten = 0;         // atlananlardan, dosya okunmadan özetten karar verilen
+    uint32_t kazanilan_bayt = 0;  // atlanan çağrılarla flash'a yazılmayan toplam bayt
+};
+
+struct satir_araligi
+{
+    uint32_t ilk; // ilk satır (0 tabanlı)
+    uint32_t son; // son satır (dahil), DEPO_DOSYA_SONU: dosyanın sonuna kadar
+
+    static satir_araligi tek(uint32_t satir) { return {satir, satir}; }
+    static satir_araligi arasi(uint32_t ilk, uint32_t son) { return {ilk, son}; }
+    static satir_araligi sona_kadar(uint32_t ilk) { return {ilk, DEPO_DOSYA_SONU}; }
+};
+
+struct sabit_istatistik
+{
+    uint32_t ram_yazma = 0;      // sabit dosyalara RAM'de yapılan yaz/degistir/ekle/temizle
+    uint32_t ram_okuma = 0;      // RAM'den karşılanan oku/satir_oku/boyut/var_mi
+    uint32_t aktarma = 0;        // flash'a yapılan başarılı yazma (içerik aynıysa yazılmaz, sayılmaz)
+    uint32_t aktarilan_bayt = 0; // bu yazmalarla flash'a giden bayt
+    uint32_t sureden = 0;        // aktarmalardan, süre dolduğu için dongu()'de yapılan
+    uint32_t esikten = 0;        // aktarmalardan, değişiklik eşiği aşıldığı için yapılan
+};
+
+struct bloom_istatistik
+{
+    uint32_t sorgu = 0;          // süzgeci açık dosyada süzgece sorulan ara() çağrısı
+    uint32_t atlanan = 0;        // süzgeç "yok" dediği için dosya taranmadan dönülen
+    uint32_t yanlis_pozitif = 0; // süzgeç "olabilir" dediği halde satır bulunamayan
+    uint32_t yeniden_kurma = 0;  // dosya baştan taranarak süzgecin yeniden yazılması
+};
+
+struct satir_gorunumu
+{
+    const char *veri;  // yineleyicinin tamponunda, '\0' ile bitmez; sonraki adımda geçersizleşir
+    uint16_t uzunluk;  // bu parçanın uzunluğu (satır sonu hariç)
+    uint32_t no;       // satır numarası (0 tabanlı)
+    bool bas;          // parça satırın başı
+    bool son;          // parça satırın sonu; uzun satırlarda ilk parçalar için false
+
+    String metin() const
+    {
+        String s;
+        s.concat(veri, uzunluk);
+        return s;
+    }
+};
+
+struct gunluk_parcasi;
+
+class satir_akisi
+{
+public:
+    class yineleyici
+    {
+    public:
+        explicit yineleyici(satir_akisi *akis) : _akis(akis) {}
+        const satir_gorunumu &operator*() const { return _akis->_gorunum; }
+        const satir_gorunumu *operator->() const { return &_akis->_gorunum; }
+        yineleyici &operator++()
+        {
+            if (!_akis->ilerle())
+                _akis = nullptr;
+            return *this;
+        }
+        bool operator!=(const yineleyici &diger) const { return _akis != diger._akis; }
+
+    private:
+        satir_akisi *_akis;
+    };
+
+    satir_akisi(File dosya, uint32_t ilk, uint32_t son);
+    satir_akisi(File dosya, uint32_t ilk, uint32_t son, const String &kayitlar, uint16_t adet, uint32_t satirSayisi);
+    satir_akisi(const String &icerik, uint32_t ilk, uint32_t son);
+    satir_akisi(satir_akisi &&diger);
+    satir_akisi(const satir_akisi &) = delete;
+    satir_akisi &operator=(const satir_akisi &) = delete;
+    ~satir_akisi();
+    bool acik() const { return _acik; }
+    yineleyici begin() { return yineleyici(ilerle() ? this : nullptr); }
+    yineleyici end() { return yineleyici(nullptr); }
+
+private:
+    File _dosya;
+    char _tampon[DEPO_SATIR_TAMPON];
+    uint16_t _dolu = 0;
+    uint16_t _konum = 0;
+    uint32_t _satir = 0;
+    uint32_t _ilk;
+    uint32_t _son;
+    bool _satirBasi = true;
+    bool _acik;
+    satir_gorunumu _gorunum;
+    // Günlüklü dosyada: kayıtların kopyası ve çözülmüş hali (bkz. depo_gunluk.cpp)
+    gunluk_parcasi *_kayit = nullptr;
+    String _kayitlar;         // RAM'den okunan sabit dosyada içeriğin kopyası
+    bool _bellekte = false;   // satırlar _kayitlar'dan okunur
+    uint32_t _bellekKonum = 0;
+    uint16_t _kayitAdet = 0;
+    uint32_t _cikis = 0;      // sıradaki birleştirilmiş satır
+    uint32_t _cikisBitis = 0; // son birleştirilmiş satır + 1
+    bool _tabanda = false;    // taban satırının sonraki parçası bekleniyor
+    bool _eksik = false;      // taban günlüğün beklediğinden kısa
+    bool ilerle();
+    bool dosyadan_ilerle();
+    size_t parca_oku(char *hedef, size_t uzunluk);
+    bool gunlukten_ilerle();
+    friend class dosya_sistemi;
+};
+
+typedef bool (*bulundu_fn)(const String &yol, uint32_t satir, uint32_t konum, void *veri);
+typedef int (*satir_karsilastir)(const char *a, const char *b);
+typedef bool (*aktar_fn)(const uint8_t *parca, size_t uzunluk, void *veri);
+typedef bool (*dolas_fn)(const String &yol, bool dizin, uint32_t boyut, uint8_t derinlik, void *veri);
 
 class dosya_sistemi
 {
 public:
+    explicit dosya_sistemi(fs::FS &depo = LittleFS) : _depo(depo) {}
+    fs::FS &depo() { return _depo; }
     bool kur();
     bool var_mi(const char *isim);
     void kapat();
@@ -14,16 +256,34 @@ public:
     void boyut_genel_ayrintili();
     void listele(const char *dizinYolu, int seviye = 0);
     void listele_tumicerik();
-    int16_t satir_hesap(const char *isim);
-    String satir_oku(const char *isim, uint16_t satirNo);
+    bool dolas(const char *kok, dolas_fn fn, void *veri);
+    int16_t kullanim_agaci(const char *kok, dizin_kullanim *dizinler, uint16_t maxDizin);
+    void kullanim_listele(const char *kok = "/");
+    bool kullanim_sayaci_ac();
+    void kullanim_sayaci_kapat();
+    int32_t bos_alan();
+    int32_t satir_hesap(const char *isim);
+    String satir_oku(const char *isim, uint32_t satirNo);
     String oku(const char *isim);
-    String oku(const char *isim, uint16_t ilkSatir, uint16_t sonSatir = 0xFFFF);
+    String oku(const char *isim, uint32_t ilkSatir, uint32_t sonSatir = DEPO_SATIR_YOK);
+    String oku(const char *isim, const satir_araligi &aralik);
+    int32_t aktar(const char *isim, Print &hedef, uint32_t konum = 0, uint32_t uzunluk = DEPO_DOSYA_SONU);
+    int32_t aktar(const char *isim, Print &hedef, const satir_araligi &aralik);
+    int32_t aktar(const char *isim, aktar_fn fn, void *veri, uint32_t konum = 0, uint32_t uzunluk = DEPO_DOSYA_SONU);
+    int32_t aktar(const char *isim, aktar_fn fn, void *veri, const satir_araligi &aralik);
     bool satirOku(File &dosya, String &satir);
+    satir_akisi satirlar(const char *isim, uint32_t ilkSatir = 0, uint32_t sonSatir = DEPO_DOSYA_SONU);
+    String son_satirlar(const char *isim, uint32_t adet);
+    String oku_konumdan(const char *isim, uint32_t konum, uint32_t *yeniKonum = nullptr);
     bool yedekle(const char *dosyaAdi);
     bool geri_yukle(const char *dosyaAdi);
-    int16_t ara(const char *isim, const String &aranan);
-    bool satir_degistir(const char *isim, uint16_t satirNo, const String &yeniIcerik);
-    bool satir_ekle(const char *isim, uint16_t konum, const String &veri);
+    int32_t ara(const char *isim, const String &aranan);
+    uint32_t agacta_ara(const char *kok, const char *aranan, bulundu_fn fn, void *veri,
+                        ara_modu mod = ARA_ICERIR, const char *uzanti = nullptr);
+    bool satir_degistir(const char *isim, uint32_t satirNo, const String &yeniIcerik);
+    bool satir_ekle(const char *isim, uint32_t konum, const String &veri);
+    bool yama(const char *isim, uint32_t konum, const uint8_t *veri, size_t uzunluk);
+    bool yama(const char *isim, uint32_t konum, const String &veri);
     bool yaz(const char *isim, const String &veri);
     bool yaz(const char *isim, int veri);
     bool yaz(const char *isim, float veri);
@@ -41,8 +301,208 @@ public:
     void ekle(const char *isim, float yeniIcerik);
     void sil_full_dizin(const char *dizinYolu);
     void sil(const char *dosyaAdi);
-    void sil(const char *dosyaAdi, uint16_t ilkSatir, uint16_t sonSatir = 0xFFFF);
-    bool satir_sil(const char *isim, uint16_t satirNo);
+    void sil(const char *dosyaAdi, uint32_t ilkSatir, uint32_t sonSatir = DEPO_SATIR_YOK);
+    void sil(const char *dosyaAdi, const satir_araligi &aralik);
+    bool satir_sil(const char *isim, uint32_t satirNo);
+    bool sirala(const char *kaynak, const char *hedef, satir_karsilastir karsilastir = nullptr,
+                bool tekil = false, sirala_rapor *rapor = nullptr);
     void temizle(const char *isim);
+    bool sabitle(const char *isim, uint16_t maxBoyut = 1024);
+    bool sabit_birak(const char *isim);
+    void sabit_ayarla(uint32_t sureMs, uint16_t degisiklikEsigi);
+    bool diske_aktar(const char *isim = nullptr);
+    void dongu();
+    sabit_istatistik sabit_istatistikleri() const { return _sabitIstatistik; }
+    bool gunluk_ac(const char *isim, uint16_t esik = DEPO_GUNLUK_ESIK);
+    bool gunluk_kapat(const char *isim);
+    bool gunluk_sikistir(const char *isim = nullptr);
+    bool bloom_ac(const char *isim, uint32_t beklenenSatir, float hataOrani = 0.01f);
+    bool bloom_kapat(const char *isim);
+    bloom_istatistik bloom_istatistikleri() const { return _bloomIstatistik; }
+    bool arsivle(const char *kok, const char *arsivYolu, arsiv_rapor *rapor = nullptr);
+    bool arsivden_cikar(const char *arsivYolu, const char *hedefKok = "/", arsiv_rapor *rapor = nullptr);
     void test();
+    static uint32_t crc32(const void *veri, size_t uzunluk, uint32_t onceki = 0);
+    static uint32_t yol_ozeti(const char *isim);
+    ozet_istatistik ozet_istatistikleri() const { return _ozetIstatistik; }
+    void ozetleri_temizle();
+
+    template <typename T>
+    bool yaz_yapi(const char *isim, const T &veri, uint16_t surum = 0)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "yaz_yapi: tip trivially copyable olmali");
+        static_assert(sizeof(T) <= 0xFFFF, "yaz_yapi: tip 65535 bayttan buyuk olamaz");
+        return yapi_yaz(isim, &veri, sizeof(T), surum);
+    }
+
+    template <typename T>
+    bool oku_yapi(const char *isim, T &veri, uint16_t surum = 0)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "oku_yapi: tip trivially copyable olmali");
+        static_assert(sizeof(T) <= 0xFFFF, "oku_yapi: tip 65535 bayttan buyuk olamaz");
+        return yapi_oku(isim, &veri, sizeof(T), surum);
+    }
+
+    template <typename T>
+    bool yaz_eleman(const char *isim, uint32_t sira, const T &veri)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "yaz_eleman: tip trivially copyable olmali");
+        return eleman_yaz(isim, sira * sizeof(T), &veri, sizeof(T));
+    }
+
+    template <typename T>
+    bool oku_eleman(const char *isim, uint32_t sira, T &veri)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "oku_eleman: tip trivially copyable olmali");
+        return eleman_oku(isim, sira * sizeof(T), &veri, sizeof(T));
+    }
+
+    template <typename T>
+    int32_t eleman_sayisi(const char *isim)
+    {
+        int32_t b = boyut(isim);
+        return b < 0 ? -1 : b / (int32_t)sizeof(T);
+    }
+
+private:
+    friend class log_yoneticisi;
+    fs::FS &_depo;
+    bool _sayacAktif = false;
+    uint32_t _toplamBayt = 0;
+    uint32_t _kullanilanBayt = 0;
+    uint16_t _geciciSayac = 0;
+    struct ozet_kaydi
+    {
+        uint32_t yol;   // yol_ozeti(), 0 ise kayıt boş
+        uint32_t boyut;
+        uint32_t crc;
+    };
+    ozet_kaydi _ozetler[DEPO_OZET_SAYISI] = {};
+    uint8_t _ozetSira = 0;
+    ozet_istatistik _ozetIstatistik;
+    struct sabit_kaydi
+    {
+        uint32_t yol = 0;        // yol_ozeti(), 0 ise kayıt boş
+        String isim;
+        String icerik;           // dosyanın RAM'deki güncel hali
+        uint16_t maxBoyut = 0;
+        uint16_t degisiklik = 0; // son aktarmadan bu yana RAM yazması
+        uint32_t kirliZaman = 0; // ilk aktarılmamış yazmanın zamanı (millis)
+        bool var = false;        // dosya (RAM'deki haliyle) mevcut mu
+        bool yuklu = false;      // icerik geçerli mi; değilse flash kullanılır
+        bool kirli = false;      // icerik flash'tan farklı
+        bool aktariliyor = false;
+    };
+    sabit_kaydi _sabitler[DEPO_SABIT_SAYISI];
+    uint8_t _sabitAdet = 0;
+    uint32_t _sabitSure = DEPO_SABIT_SURE;
+    uint16_t _sabitEsik = DEPO_SABIT_ESIK;
+    sabit_istatistik _sabitIstatistik;
+    sabit_kaydi *sabit_bul(const char *isim);
+    void sabit_aktar(const char *isim);
+    bool sabit_diske_yaz(sabit_kaydi &s, uint32_t *sebep = nullptr);
+    void sabit_yenile(sabit_kaydi &s);
+    bool sabite_yaz(const char *isim, const String &veri, bool sonaEkle);
+    bool sabitten_oku(const char *isim, String *icerik, int32_t *boyut);
+    const String *sabit_icerik(const char *isim);
+    int8_t sabit_oku(const char *isim, uint32_t ilk, uint32_t son, aktar_fn fn, void *veri);
+    int32_t sabit_satir_sayisi(const char *isim);
+    struct bloom_kaydi
+    {
+        uint32_t yol = 0;       // yol_ozeti(), 0 ise kayıt boş
+        String isim;
+        uint32_t bit = 0;       // bit dizisinin uzunluğu (m)
+        uint8_t ozetSayisi = 0; // satır başına işaretlenen bit (k)
+        bool eski = true;       // süzgeç dosyayı yansıtmıyor; ara() yeniden kurar
+    };
+    bloom_kaydi _bloomlar[DEPO_BLOOM_SAYISI];
+    uint8_t _bloomAdet = 0;
+    bloom_istatistik _bloomIstatistik;
+    bloom_kaydi *bloom_bul(const char *isim);
+    bool bloom_kur(bloom_kaydi &b);
+    int8_t bloom_sorgu(bloom_kaydi &b, const String &aranan, bool kurabilir);
+    void bloom_ekle(bloom_kaydi &b, const String &veri);
+    struct gunluk_kaydi
+    {
+        uint32_t yol = 0;         // yol_ozeti(), 0 ise kayıt boş
+        String isim;
+        String kayitlar;          // günlük kayıtlarının RAM kopyası (başlık hariç)
+        uint16_t esik = 0;
+        uint16_t kayitSayisi = 0;
+        uint32_t satir = 0;       // günlük uygulanmış haliyle satır sayısı
+        bool sayildi = false;     // satir geçerli mi; değilse taban dosyadan sayılır
+        bool var = false;         // taban dosya var mı
+        bool tabanSonu = true;    // taban dosya boş veya '\n' ile bitiyor
+        int32_t boyut = -1;       // birleştirilmiş içeriğin boyutu, -1: hesaplanmadı
+        bool isleniyor = false;   // günlük tabana işleniyor
+    };
+    gunluk_kaydi _gunlukler[DEPO_GUNLUK_SAYISI];
+    uint8_t _gunlukAdet = 0;
+    gunluk_kaydi *gunluk_bul(const char *isim);
+    void gunluk_isle(const char *isim);
+    int8_t gunluk_duzenle(const char *isim, gunluk_turu tur, uint32_t satir, const String *veri);
+    bool gunluk_say(gunluk_kaydi &g);
+    bool gunluk_kaydet(gunluk_kaydi &g, gunluk_turu tur, uint32_t satir, const String *veri);
+    bool gunluk_dosyasi_yaz(gunluk_kaydi &g);
+    int8_t gunluk_oku(const char *isim, uint32_t ilk, uint32_t son, aktar_fn fn, void *veri);
+    int8_t gunluk_birlestir(gunluk_kaydi &g, uint32_t ilk, uint32_t son, aktar_fn fn, void *veri);
+    int32_t gunluk_boyut(gunluk_kaydi &g);
+    bool gunluk_tabana_yaz(gunluk_kaydi &g);
+    bool icerik_ayni(const char *isim, const String &veri, uint32_t &crc);
+    void ozet_kaydet(const char *isim, uint32_t boyut, uint32_t crc);
+    bool dosyalar_ayni(const char *a, const char *b);
+    bool satir_konumu(const char *isim, uint32_t satirNo, uint32_t &bas, uint32_t &uzunluk);
+    bool satirlari_yeniden_yaz(const char *isim, uint32_t ilk, uint32_t silinecek,
+                               const String *eklenecek, uint32_t *silinen = nullptr);
+    String gecici_isim();
+    bool yerine_koy(const char *gecici, const char *isim);
+    uint32_t sayac_boyut(const char *isim);
+    bool kapasite(size_t &toplam, size_t &kullanilan);
+    void dosya_degisti(const char *isim, int32_t fark);
+    bool yapi_yaz(const char *isim, const void *veri, size_t uzunluk, uint16_t surum);
+    bool yapi_oku(const char *isim, void *veri, size_t uzunluk, uint16_t surum);
+    bool eleman_yaz(const char *isim, uint32_t konum, const void *veri, size_t uzunluk);
+    bool eleman_oku(const char *isim, uint32_t konum, void *veri, size_t uzunluk);
+};
+
+class log_yoneticisi
+{
+public:
+    log_yoneticisi(dosya_sistemi &fs, const char *dizin = "/log", uint32_t segmentBoyut = 4096, uint32_t toplamKota = 32768);
+    bool baslat();
+    bool ekle(const String &satir);
+    bool dondur();
+    void temizle();
+    uint32_t toplam_boyut() const { return _toplam; }
+    uint32_t ilk_segment() const { return _ilk; }
+    uint32_t son_segment() const { return _son; }
+    bool bos() const { return _bos; }
+    String segment_yolu(uint32_t no) const;
+    fs::FS &depo() { return _fs.depo(); }
+
+private:
+    dosya_sistemi &_fs;
+    String _dizin;
+    uint32_t _segmentBoyut;
+    uint32_t _kota;
+    uint32_t _ilk = 0;
+    uint32_t _son = 0;
+    uint32_t _sonBoyut = 0;
+    uint32_t _toplam = 0;
+    bool _bos = true;
+    void kotayi_uygula();
+};
+
+class log_okuyucu
+{
+public:
+    log_okuyucu(log_yoneticisi &log);
+    bool sonraki(String &satir);
+    void kapat();
+
+private:
+    log_yoneticisi &_log;
+    uint32_t _segment;
+    File _dosya;
+    bool _bitti;
 };
\ No newline at end of file
@@ -0,0 +1,328 @@
+#include "LITTLEFS_LIB.h"
+
+// Arşiv biçimi (tüm alanlar little-endian, hizalamasız ardışık):
+//   arsiv_basligi
+//   her girdi için: arsiv_girdisi, yol (goreli, sonunda '\0' yok),
+//                   dosyaysa `boyut` bayt içerik ve 4 bayt CRC-32
+//   arsiv_girdisi{ARSIV_SON}, boyut alanında girdi sayısı
+// CRC içerikten sonra yazılır; böylece arşiv tek geçişte, geri dönmeden yazılır.
+
+enum arsiv_turu : uint8_t
+{
+    ARSIV_SON = 0,
+    ARSIV_DOSYA = 1,
+    ARSIV_DIZIN = 2
+};
+
+struct arsiv_basligi
+{
+    uint32_t imza;   // DEPO_ARSIV_IMZA
+    uint16_t surum;  // 1
+    uint16_t bayrak; // 0: sıkıştırma yok
+};
+
+struct arsiv_girdisi
+{
+    uint8_t tur;         // arsiv_turu
+    uint8_t yolUzunlugu; // kök klasöre göre yolun uzunluğu
+    uint16_t ayrilmis;
+    uint32_t boyut;      // dosya içeriği (bayt), ARSIV_SON için girdi sayısı
+};
+
+struct arsiv_yazimi
+{
+    dosya_sistemi *fs;
+    File *arsiv;
+    const char *arsivYolu;
+    size_t kokUzunlugu;
+    arsiv_rapor *rapor;
+    uint32_t girdi;
+    uint32_t crc; // yazılmakta olan dosyanın CRC'si
+    bool tamam;
+};
+
+static bool arsive_yaz(File &arsiv, const void *veri, size_t uzunluk)
+{
+    return arsiv.write((const uint8_t *)veri, uzunluk) == uzunluk;
+}
+
+/**
+ * @brief Günlük (.jrn) ve Bloom süzgeci (.blm) yan dosyası mı?
+ *
+ * Günlüklü dosya arşive günlük uygulanmış haliyle girer; yanındaki .jrn geri
+ * açılırsa gunluk_ac() onu bu içeriğe ikinci kez uygulayabilirdi. .blm ise
+ * dosyadan yeniden kurulur. Bu yüzden ikisi de arşivlenmez ve açılmaz.
+ */
+static bool yan_dosya_mi(const String &yol)
+{
+    return yol.endsWith(".jrn") || yol.endsWith(".blm");
+}
+
+/**
+ * @brief aktar() ile gelen dosya içeriğini CRC'sini hesaplayarak arşive yazar.
+ */
+static bool arsive_aktar(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    arsiv_yazimi *a = (arsiv_yazimi *)veri;
+    a->crc = dosya_sistemi::crc32(parca, uzunluk, a->crc);
+    a->tamam = arsive_yaz(*a->arsiv, parca, uzunluk);
+    return a->tamam;
+}
+
+/**
+ * @brief dolas() ile gelen her girdiyi arşivin sonuna ekler.
+ *
+ * Arşivin kendisi, geçici dosyalar ve .jrn/.blm yan dosyaları atlanır. Dosya içeriği aktar() ile
+ * parça parça okunup aynı anda CRC'si hesaplanarak yazılır; sabit dosyalar
+ * RAM'deki, günlüklü dosyalar günlük uygulanmış halleriyle arşive girer.
+ */
+static bool arsive_ekle(const String &yol, bool dizin, uint32_t boyut, uint8_t derinlik, void *veri)
+{
+    arsiv_yazimi *a = (arsiv_yazimi *)veri;
+    (void)boyut; // dolaşmadaki boyut eskimiş olabilir; kilit altında yeniden alınır
+    (void)derinlik;
+    if (yol == a->arsivYolu || yol.startsWith("/__gecici_") || yan_dosya_mi(yol))
+        return true;
+
+    String goreli = yol.substring(a->kokUzunlugu);
+    if (goreli.length() == 0 || goreli.length() > 255)
+    {
+        a->rapor->atlanan++;
+        return true;
+    }
+
+    arsiv_girdisi g = {dizin ? ARSIV_DIZIN : ARSIV_DOSYA, (uint8_t)goreli.length(), 0, 0};
+    if (dizin)
+    {
+        a->tamam = arsive_yaz(*a->arsiv, &g, sizeof(g)) && arsive_yaz(*a->arsiv, goreli.c_str(), g.yolUzunlugu);
+        a->rapor->dizin++;
+        a->girdi++;
+        return a->tamam;
+    }
+
+    yol_kilidi kilit(yol.c_str(), false);
+    int32_t bayt = a->fs->boyut(yol.c_str()); // dolaşmadan bu yana değişmiş olabilir, kilit altında tekrar alınır
+    if (bayt < 0)
+    {
+        a->rapor->atlanan++;
+        return true;
+    }
+    g.boyut = bayt;
+    a->tamam = arsive_yaz(*a->arsiv, &g, sizeof(g)) && arsive_yaz(*a->arsiv, goreli.c_str(), g.yolUzunlugu);
+
+    a->crc = 0;
+    int32_t aktarilan = a->tamam ? a->fs->aktar(yol.c_str(), arsive_aktar, a) : 0;
+    // Eksik okunan dosya arşivin geri kalanını kaydırır; arşiv geçersiz sayılır
+    a->tamam = a->tamam && aktarilan == bayt && arsive_yaz(*a->arsiv, &a->crc, sizeof(a->crc));
+
+    a->rapor->dosya++;
+    a->rapor->bayt += g.boyut;
+    a->girdi++;
+    return a->tamam;
+}
+
+/**
+ * @brief Bir klasör ağacını tek bir arşiv dosyasına yazar.
+ *
+ * Ağaç dolas() ile gezilir ve her klasör/dosya sırayla tek bir yazma akışına
+ * eklenir: dosya başına ayrı kopya, açma ve meta veri güncellemesi yapılmaz.
+ * Her dosya için yol, boyut ve CRC-32 saklanır; sıkıştırma yapılmaz.
+ * Günlüklü dosyalar günlük uygulanmış haliyle yazılır; .jrn ve .blm yan
+ * dosyaları arşive girmez (açılınca günlük kapalı, süzgeç yeniden kurulur).
+ * Arşiv önce geçici dosyaya yazılır, tamamlanınca yerine_koy() ile
+ * `arsivYolu`na taşınır; yarıda kalırsa (örn. disk dolu) önceki arşiv
+ * korunur. Taşınamazsa rapordaki hata sayısı artar.
+ * DEPO_MAX_DERINLIK'ten derin klasörler arşive girmez.
+ *
+ * @param kok Arşivlenecek klasör (örn: "/")
+ * @param arsivYolu Oluşturulacak arşiv dosyası (ağacın içinde olabilir, kendisi atlanır)
+ * @param rapor Dosya/klasör/bayt sayıları (isteğe bağlı)
+ * @return true Arşiv eksiksiz yazıldıysa
+ */
+bool dosya_sistemi::arsivle(const char *kok, const char *arsivYolu, arsiv_rapor *rapor)
+{
+    arsiv_rapor r;
+    diske_aktar(); // sabit dosyalar dolaşmada güncel boyutlarıyla görünsün
+    yol_kilidi kilit(arsivYolu, true);
+    if (!kilit.tamam())
+    {
+        if (rapor)
+            *rapor = r;
+        return false;
+    }
+    int32_t eskiBoyut = sayac_boyut(arsivYolu);
+
+    String geciciIsim = gecici_isim();
+    File arsiv = _depo.open(geciciIsim.c_str(), "w");
+    if (!arsiv)
+    {
+        if (rapor)
+            *rapor = r;
+        return false;
+    }
+
+    size_t kokUzunlugu = strlen(kok);
+    arsiv_yazimi a = {this, &arsiv, arsivYolu, kokUzunlugu + (String(kok).endsWith("/") ? 0 : 1), &r, 0, 0, true};
+    arsiv_basligi b = {DEPO_ARSIV_IMZA, 1, 0};
+    a.tamam = arsive_yaz(arsiv, &b, sizeof(b));
+    bool kokVar = a.tamam && dolas(kok, arsive_ekle, &a);
+
+    arsiv_girdisi son = {ARSIV_SON, 0, 0, a.girdi};
+    a.tamam = a.tamam && arsive_yaz(arsiv, &son, sizeof(son));
+    int32_t yeniBoyut = arsiv.size();
+    arsiv.close();
+
+    bool tamam = kokVar && a.tamam;
+    if (!tamam)
+        _depo.remove(geciciIsim.c_str());
+    else if (yerine_koy(geciciIsim.c_str(), arsivYolu))
+        dosya_degisti(arsivYolu, yeniBoyut - eskiBoyut);
+    else
+    {
+        r.hata++;
+        tamam = false;
+    }
+    if (rapor)
+        *rapor = r;
+    return tamam;
+}
+
+/**
+ * @brief arsivle() ile üretilmiş bir arşivi klasör ağacına geri açar.
+ *
+ * Arşiv baştan sona tek geçişte okunur. Her dosya önce geçici dosyaya
+ * yazılır, CRC tutarsa hedefin yerine konur; tutmazsa hedefe dokunulmaz ve
+ * hata sayılır. Yerine konamayan dosya da hata sayılır. Var olan dosyaların üzerine yazılır, klasörler gerekirse
+ * oluşturulur. Eski arşivlerde bulunabilecek .jrn/.blm yan dosyaları
+ * açılmaz, atlanan olarak sayılır.
+ *
+ * @param arsivYolu Açılacak arşiv dosyası
+ * @param hedefKok Ağacın açılacağı klasör (örn: "/" veya "/geri")
+ * @param rapor Dosya/klasör/bayt ve hata sayıları (isteğe bağlı)
+ * @return true Tüm girdiler hatasız açıldı ve arşiv sonu doğrulandıysa
+ */
+bool dosya_sistemi::arsivden_cikar(const char *arsivYolu, const char *hedefKok, arsiv_rapor *rapor)
+{
+    arsiv_rapor r;
+    // Yazılan dosyalardan biri arşivle aynı kilit yuvasına düşebilir; okuma
+    // kilidini yazmaya yükseltmemek için arşiv baştan yazma kilidiyle tutulur.
+    yol_kilidi kilit(arsivYolu, true);
+    if (!kilit.tamam())
+    {
+        if (rapor)
+            *rapor = r;
+        return false;
+    }
+    File arsiv = _depo.open(arsivYolu, "r");
+    arsiv_basligi b;
+    if (!arsiv || arsiv.isDirectory() || arsiv.read((uint8_t *)&b, sizeof(b)) != sizeof(b) ||
+        b.imza != DEPO_ARSIV_IMZA || b.surum != 1 || b.bayrak != 0)
+    {
+        Serial.print(F("Gecersiz arsiv: "));
+        Serial.print(arsivYolu);
+        Serial.print(F("\n"));
+        if (rapor)
+            *rapor = r;
+        return false;
+    }
+
+    String taban = hedefKok;
+    if (!taban.endsWith("/"))
+    {
+        if (!_depo.exists(hedefKok))
+            _depo.mkdir(hedefKok);
+        taban += "/";
+    }
+
+    uint8_t tampon[DEPO_ARSIV_TAMPON];
+    char ad[256];
+    uint32_t girdi = 0;
+    bool bitti = false;
+    while (!bitti)
+    {
+        arsiv_girdisi g;
+        if (arsiv.read((uint8_t *)&g, sizeof(g)) != sizeof(g))
+            break; // arşiv kesik
+        if (g.tur == ARSIV_SON)
+        {
+            bitti = g.boyut == girdi;
+            break;
+        }
+        if ((g.tur != ARSIV_DOSYA && g.tur != ARSIV_DIZIN) || arsiv.read((uint8_t *)ad, g.yolUzunlugu) != g.yolUzunlugu)
+            break;
+        ad[g.yolUzunlugu] = '\0';
+        String yol = taban + ad;
+        girdi++;
+
+        if (g.tur == ARSIV_DIZIN)
+        {
+            if (_depo.exists(yol.c_str()) || _depo.mkdir(yol.c_str()))
+                r.dizin++;
+            else
+                r.hata++;
+            continue;
+        }
+
+        if (yan_dosya_mi(yol))
+        {
+            if (!arsiv.seek(g.boyut + sizeof(uint32_t), SeekCur))
+                break; // arşiv kesik
+            r.atlanan++;
+            continue;
+        }
+
+        yol_kilidi dosyaKilidi(yol.c_str(), true);
+        String geciciIsim = gecici_isim();
+        File yeni = _depo.open(geciciIsim.c_str(), "w");
+        bool tamam = (bool)yeni;
+        uint32_t crc = 0;
+        uint32_t kalan = g.boyut;
+        while (kalan > 0)
+        {
+            size_t n = arsiv.read(tampon, kalan < sizeof(tampon) ? kalan : sizeof(tampon));
+            if (n == 0)
+                break;
+            crc = crc32(tampon, n, crc);
+            if (tamam)
+                tamam = yeni.write(tampon, n) == n;
+            kalan -= n;
+        }
+        if (yeni)
+            yeni.close();
+
+        uint32_t saklananCrc = 0;
+        if (kalan > 0 || arsiv.read((uint8_t *)&saklananCrc, sizeof(saklananCrc)) != sizeof(saklananCrc))
+        {
+            _depo.remove(geciciIsim.c_str());
+            r.hata++;
+            break; // arşiv kesik
+        }
+        if (!tamam || crc != saklananCrc)
+        {
+            _depo.remove(geciciIsim.c_str());
+            r.hata++;
+            continue;
+        }
+
+        int32_t eskiBoyut = sayac_boyut(yol.c_str());
+        if (!yerine_koy(geciciIsim.c_str(), yol.c_str()))
+        {
+            r.hata++;
+            continue;
+        }
+        dosya_degisti(yol.c_str(), (int32_t)g.boyut - eskiBoyut);
+        r.dosya++;
+        r.bayt += g.boyut;
+    }
+    arsiv.close();
+
+    if (!bitti)
+    {
+        Serial.print(F("Arsiv eksik veya bozuk: "));
+        Serial.print(arsivYolu);
+        Serial.print(F("\n"));
+    }
+    if (rapor)
+        *rapor = r;
+    return bitti && r.hata == 0;
+}
@@ -0,0 +1,371 @@
+#include "LITTLEFS_LIB.h"
+
+// Süzgeç yan dosyası (isim + ".blm"):
+//   bloom_basligi
+//   bit / 8 bayt bit dizisi; n. bit, n / 8. baytın (n % 8). bitidir
+// Her satır için iki özet (CRC-32 ve FNV-1a) hesaplanır; i. bit (h1 + i * h2) % bit
+// formülüyle bulunur (çift özetleme). Satır sonu karakteri özete katılmaz.
+
+struct bloom_basligi
+{
+    uint32_t imza;        // DEPO_BLOOM_IMZA
+    uint32_t bit;         // bit dizisinin uzunluğu (m)
+    uint8_t ozetSayisi;   // satır başına işaretlenen bit (k)
+    uint8_t ayrilmis[3];
+    uint32_t dosyaBoyutu; // süzgecin yansıttığı dosya boyutu
+};
+
+struct bloom_ozeti
+{
+    uint32_t h1 = 0;
+    uint32_t h2 = 2166136261UL; // FNV-1a başlangıç değeri
+
+    void ekle(const char *veri, size_t uzunluk)
+    {
+        h1 = dosya_sistemi::crc32(veri, uzunluk, h1);
+        for (size_t i = 0; i < uzunluk; i++)
+            h2 = (h2 ^ (uint8_t)veri[i]) * 16777619UL;
+    }
+
+    uint32_t bit(uint8_t i, uint32_t m) const { return (h1 + i * (h2 | 1)) % m; }
+};
+
+static bool bloom_basligi_oku(File &yan, const uint32_t bit, const uint8_t ozetSayisi, bloom_basligi &baslik)
+{
+    return yan.read((uint8_t *)&baslik, sizeof(baslik)) == sizeof(baslik) && baslik.imza == DEPO_BLOOM_IMZA &&
+           baslik.bit == bit && baslik.ozetSayisi == ozetSayisi;
+}
+
+/**
+ * @brief Satır dosyası için Bloom süzgeci açar.
+ *
+ * Süzgeç `isim + ".blm"` yan dosyasında tutulur. Açıkken ara() önce süzgece
+ * bakar: satır dosyada kesin yoksa dosya taranmadan -1 döner; bunun için
+ * yan dosyadan en fazla k bayt okunur. "Olabilir" cevabı gelirse dosya her
+ * zamanki gibi taranır, yani süzgeç yanlış cevaba yol açmaz.
+ *
+ * ekle() süzgeci yerinde günceller. Dosyayı yeniden yazan diğer işlemler
+ * (satır silme/değiştirme, sirala, yaz, ...) süzgeci eskitir; süzgeç ilk
+ * ara() çağrısında dosya bir kez taranarak yeniden kurulur.
+ *
+ * Yan dosya zaten varsa ve aynı ayarlarla bu dosyanın şimdiki boyutu için
+ * kurulmuşsa yeniden kullanılır. Kütüphane dışında (başka bir nesneyle)
+ * boyutu değiştirilmeden yapılan değişiklikler fark edilmez.
+ *
+ * @param isim Dosya yolu (dosyanın var olması gerekmez)
+ * @param beklenenSatir Dosyanın ulaşması beklenen satır sayısı
+ * @param hataOrani Bu satır sayısında hedeflenen yanlış pozitif oranı (0.0001 - 0.5)
+ * @return true Süzgeç açıldıysa, false tablo doluysa veya yan dosya yazılamadıysa
+ */
+bool dosya_sistemi::bloom_ac(const char *isim, uint32_t beklenenSatir, float hataOrani)
+{
+    if (beklenenSatir == 0)
+        beklenenSatir = 1;
+    hataOrani = constrain(hataOrani, 0.0001f, 0.5f);
+
+    // m = -n ln(p) / ln(2)^2, k = m / n ln(2)
+    float m = -(float)beklenenSatir * logf(hataOrani) / (0.6931472f * 0.6931472f);
+    m = constrain(m, 64.0f, DEPO_BLOOM_MAX_BAYT * 8.0f);
+    uint32_t bit = ((uint32_t)m + 7) & ~7UL;
+    uint8_t ozetSayisi = (uint8_t)constrain(lroundf(bit * 0.6931472f / beklenenSatir), 1L, 16L);
+
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    bloom_kaydi *b = bloom_bul(isim);
+    for (uint8_t i = 0; i < DEPO_BLOOM_SAYISI && !b; i++)
+    {
+        if (_bloomlar[i].yol == 0)
+            b = &_bloomlar[i];
+    }
+    if (!b)
+        return false;
+
+    bool yeni = b->yol == 0;
+    b->isim = isim;
+    b->bit = bit;
+    b->ozetSayisi = ozetSayisi;
+    b->eski = true;
+
+    // Önceki çalışmadan kalan yan dosya hâlâ geçerli mi?
+    sabit_aktar(isim);
+    String yanAdi = b->isim + ".blm";
+    File yan = _depo.open(yanAdi.c_str(), "r");
+    if (yan)
+    {
+        bloom_basligi baslik;
+        if (bloom_basligi_oku(yan, bit, ozetSayisi, baslik) && yan.size() == sizeof(baslik) + bit / 8)
+        {
+            File dosya = _depo.open(isim, "r");
+            b->eski = (dosya ? dosya.size() : 0) != baslik.dosyaBoyutu;
+            if (dosya)
+                dosya.close();
+        }
+        yan.close();
+    }
+    if (b->eski && !bloom_kur(*b))
+    {
+        if (yeni)
+            b->isim = "";
+        return false;
+    }
+
+    if (yeni)
+    {
+        yol_kilidi::kritik_gir();
+        b->yol = yol_ozeti(isim);
+        _bloomAdet++;
+        yol_kilidi::kritik_cik();
+    }
+    return true;
+}
+
+/**
+ * @brief Dosyanın Bloom süzgecini kapatır ve yan dosyasını siler.
+ *
+ * @param isim Dosya yolu
+ * @return true Süzgeç açıktı
+ */
+bool dosya_sistemi::bloom_kapat(const char *isim)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    bloom_kaydi *b = bloom_bul(isim);
+    if (!b)
+        return false;
+    yol_kilidi::kritik_gir();
+    b->yol = 0;
+    _bloomAdet--;
+    yol_kilidi::kritik_cik();
+
+    String yan = b->isim + ".blm";
+    uint32_t eskiBoyut = sayac_boyut(yan.c_str());
+    if (_depo.remove(yan.c_str()))
+        dosya_degisti(yan.c_str(), -(int32_t)eskiBoyut);
+    b->isim = "";
+    return true;
+}
+
+/**
+ * @brief Yolu süzgeç tablosunda arar.
+ *
+ * Süzgeç açık değilse yol özeti bile hesaplanmaz.
+ */
+dosya_sistemi::bloom_kaydi *dosya_sistemi::bloom_bul(const char *isim)
+{
+    if (_bloomAdet == 0)
+        return nullptr;
+    uint32_t ozet = yol_ozeti(isim);
+    for (uint8_t i = 0; i < DEPO_BLOOM_SAYISI; i++)
+    {
+        if (_bloomlar[i].yol == ozet && _bloomlar[i].isim == isim)
+            return &_bloomlar[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Dosyayı baştan tarayarak süzgeci yeniden yazar.
+ *
+ * Bit dizisi (en fazla DEPO_BLOOM_MAX_BAYT) tarama süresince RAM'de tutulur.
+ * Dosya yoksa boş süzgeç yazılır. Çağıran, dosyanın yazma kilidini tutmalıdır.
+ *
+ * @return true Yan dosya yazıldıysa
+ */
+bool dosya_sistemi::bloom_kur(bloom_kaydi &b)
+{
+    const char *isim = b.isim.c_str();
+    uint8_t *bitler = (uint8_t *)calloc(b.bit / 8, 1);
+    if (!bitler)
+        return false;
+
+    bloom_basligi baslik = {DEPO_BLOOM_IMZA, b.bit, b.ozetSayisi, {0, 0, 0}, 0};
+    if (var_mi(isim))
+    {
+        satir_akisi akis = satirlar(isim); // sabit dosyada RAM kopyası taranır
+        if (!akis.acik())
+        {
+            free(bitler);
+            return false;
+        }
+        bloom_ozeti ozet;
+        for (const satir_gorunumu &s : akis)
+        {
+            if (s.bas)
+                ozet = bloom_ozeti();
+            ozet.ekle(s.veri, s.uzunluk);
+            if (!s.son)
+                continue;
+            for (uint8_t i = 0; i < b.ozetSayisi; i++)
+            {
+                uint32_t n = ozet.bit(i, b.bit);
+                bitler[n / 8] |= 1 << (n % 8);
+            }
+        }
+        const String *sabit = sabit_icerik(isim);
+        File dosya = sabit ? File() : _depo.open(isim, "r");
+        if (sabit)
+            baslik.dosyaBoyutu = sabit->length(); // aktarıldığında flash'taki boyut bu olur
+        else if (dosya)
+        {
+            baslik.dosyaBoyutu = dosya.size();
+            dosya.close();
+        }
+    }
+
+    String yan = b.isim + ".blm";
+    uint32_t eskiBoyut = sayac_boyut(yan.c_str());
+    File dosya = _depo.open(yan.c_str(), "w");
+    bool tamam = false;
+    if (dosya)
+    {
+        tamam = dosya.write((const uint8_t *)&baslik, sizeof(baslik)) == sizeof(baslik) &&
+                dosya.write(bitler, b.bit / 8) == b.bit / 8;
+        dosya.close();
+        if (!tamam)
+            _depo.remove(yan.c_str());
+        dosya_degisti(yan.c_str(), (int32_t)sayac_boyut(yan.c_str()) - (int32_t)eskiBoyut);
+    }
+    free(bitler);
+
+    if (tamam)
+    {
+        b.eski = false;
+        yol_kilidi::kritik_gir();
+        _bloomIstatistik.yeniden_kurma++;
+        yol_kilidi::kritik_cik();
+    }
+    return tamam;
+}
+
+/**
+ * @brief ara() için süzgece sorar.
+ *
+ * Süzgeç eskiyse ve çağıran yazma kilidini tutuyorsa önce yeniden kurulur;
+ * okuma kilidiyle gelen çağrıda süzgeç kullanılmaz.
+ *
+ * @param b Süzgeç kaydı
+ * @param aranan Aranan satır
+ * @param kurabilir Çağıran dosyanın yazma kilidini tutuyor mu
+ * @return int8_t 0: satır kesin yok, 1: olabilir, -1: süzgeç kullanılamadı
+ */
+int8_t dosya_sistemi::bloom_sorgu(bloom_kaydi &b, const String &aranan, bool kurabilir)
+{
+    if (b.eski && (!kurabilir || !bloom_kur(b)))
+        return -1;
+
+    String yanAdi = b.isim + ".blm";
+    File yan = _depo.open(yanAdi.c_str(), "r");
+    if (!yan)
+        return -1;
+    bloom_basligi baslik;
+    if (!bloom_basligi_oku(yan, b.bit, b.ozetSayisi, baslik))
+    {
+        yan.close();
+        return -1;
+    }
+
+    bloom_ozeti ozet;
+    ozet.ekle(aranan.c_str(), aranan.length());
+    int8_t sonuc = 1;
+    for (uint8_t i = 0; i < b.ozetSayisi && sonuc == 1; i++)
+    {
+        uint32_t n = ozet.bit(i, b.bit);
+        int bayt = yan.seek(sizeof(baslik) + n / 8, SeekSet) ? yan.read() : -1;
+        if (bayt < 0)
+            sonuc = -1;
+        else if (!(bayt & (1 << (n % 8))))
+            sonuc = 0;
+    }
+    yan.close();
+
+    if (sonuc >= 0)
+    {
+        yol_kilidi::kritik_gir();
+        _bloomIstatistik.sorgu++;
+        if (sonuc == 0)
+            _bloomIstatistik.atlanan++;
+        yol_kilidi::kritik_cik();
+    }
+    return sonuc;
+}
+
+/**
+ * @brief ekle() ile dosyanın sonuna yazılan satırları süzgece işler.
+ *
+ * Eklemeden önce süzgeç güncelse çağrılır; dosya_degisti() süzgeci eskitmiş
+ * olur, güncelleme başarılı olursa süzgeç yeniden güncel sayılır. Dosya
+ * yarım bir satırla bitiyorduysa eklenen veri o satırı uzatmıştır; bu
+ * durumda süzgeç eski kalır ve ara() tarafından yeniden kurulur.
+ * Çağıran, dosyanın yazma kilidini tutmalıdır.
+ *
+ * @param b Süzgeç kaydı
+ * @param veri Dosyanın sonuna eklenen içerik
+ */
+void dosya_sistemi::bloom_ekle(bloom_kaydi &b, const String &veri)
+{
+    const char *isim = b.isim.c_str();
+    size_t uzunluk = veri.length();
+
+    // Dosyanın yeni boyutu ve eklenen verinin önündeki karakter
+    uint32_t boyut = 0;
+    char onceki = '\n';
+    sabit_kaydi *s = sabit_bul(isim);
+    if (s && s->yuklu)
+    {
+        boyut = s->icerik.length();
+        if (boyut > uzunluk)
+            onceki = s->icerik[boyut - uzunluk - 1];
+    }
+    else
+    {
+        File dosya = _depo.open(isim, "r");
+        if (!dosya)
+            return;
+        boyut = dosya.size();
+        if (boyut > uzunluk && dosya.seek(boyut - uzunluk - 1, SeekSet))
+            onceki = dosya.read();
+        dosya.close();
+    }
+    if (onceki != '\n' || boyut < uzunluk)
+        return;
+
+    String yanAdi = b.isim + ".blm";
+    File yan = _depo.open(yanAdi.c_str(), "r+");
+    if (!yan)
+        return;
+    bloom_basligi baslik;
+    bool tamam = bloom_basligi_oku(yan, b.bit, b.ozetSayisi, baslik);
+
+    const char *p = veri.c_str();
+    size_t bas = 0;
+    while (tamam && bas < uzunluk)
+    {
+        const char *nl = (const char *)memchr(p + bas, '\n', uzunluk - bas);
+        size_t son = nl ? (size_t)(nl - p) : uzunluk;
+        bloom_ozeti ozet;
+        ozet.ekle(p + bas, son - bas);
+        for (uint8_t i = 0; i < b.ozetSayisi && tamam; i++)
+        {
+            uint32_t n = ozet.bit(i, b.bit);
+            uint32_t konum = sizeof(baslik) + n / 8;
+            int bayt = yan.seek(konum, SeekSet) ? yan.read() : -1;
+            if (bayt < 0)
+                tamam = false;
+            else if (!(bayt & (1 << (n % 8))))
+            {
+                uint8_t yeni = bayt | (1 << (n % 8));
+                tamam = yan.seek(konum, SeekSet) && yan.write(&yeni, 1) == 1;
+            }
+        }
+        bas = son + 1;
+    }
+
+    baslik.dosyaBoyutu = boyut;
+    tamam = tamam && yan.seek(0, SeekSet) && yan.write((const uint8_t *)&baslik, sizeof(baslik)) == sizeof(baslik);
+    yan.close();
+    dosya_degisti(yanAdi.c_str(), 0);
+    if (tamam)
+        b.eski = false;
+}
@@ -0,0 +1,586 @@
+#include "LITTLEFS_LIB.h"
+
+// Günlük dosyası (isim + ".jrn"), metin:
+//   G<taban dosyanın boyutu>\n          günlük bu boyuttaki tabana uygulanır
+//   D<satır> <yeni içerik>\n            satir_degistir
+//   E<satır> <içerik>\n                 satir_ekle
+//   S<satır>\n                          satir_sil
+// Satır numaraları, kayıt yazıldığı andaki (önceki kayıtlar uygulanmış) içeriğe
+// göredir. Okurken istenen satır, kayıtlar sondan başa dolaşılarak ya bir
+// kayda ya da taban dosyadaki bir satıra çevrilir.
+
+struct gunluk_parcasi
+{
+    uint32_t satir;
+    uint32_t bas;      // içeriğin kayitlar içindeki konumu
+    uint16_t uzunluk;
+    char tur;
+};
+
+static bool dosyaya_yaz(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    return ((File *)veri)->write(parca, uzunluk) == uzunluk;
+}
+
+/**
+ * @brief Bir dosya için günlüklü satır düzenlemeyi açar.
+ *
+ * Açıkken satir_degistir, satir_ekle ve satir_sil dosyayı yeniden yazmaz;
+ * her düzenleme `isim + ".jrn"` günlüğünün sonuna küçük bir kayıt olarak
+ * eklenir, böylece maliyet dosya boyutuna değil düzenlemenin boyutuna bağlıdır.
+ * Okuyan işlemler (oku, satir_oku, satirlar, ara, aktar, boyut, ...) günlüğü
+ * taban dosyayla okurken birleştirir. Günlük yalnızca `esik` bayta ulaşınca,
+ * gunluk_sikistir() / gunluk_kapat() / kapat() çağrılınca veya tabanı yerinde
+ * değiştiren bir işlemden (ekle, yama, satır aralığı silme, ...) önce tabana
+ * işlenir.
+ *
+ * Günlük kayıtları RAM'de de tutulur (en fazla `esik` bayt). Önceki çalışmadan
+ * kalan günlük, taban dosyanın boyutu tutuyorsa yüklenir. RAM'e sabitlenmiş
+ * dosyada kullanılamaz.
+ *
+ * İçerik günlüksüz düzenlemeyle bayt bayt aynı kalır: satir_ekle ve satir_sil
+ * dosyayı her zaman '\n' ile bitirir, satir_degistir ise yalnızca satırın
+ * uzunluğu değişirse. Bu yüzden taban dosya '\n' ile bitmiyorsa ve günlük
+ * boşsa satir_degistir günlüğe yazılmaz, günlüksüz yoldan yapılır (aynı
+ * uzunluktaysa yerinde yama, değilse dosya '\n' ile biten haliyle yeniden
+ * yazılır). Böylece günlükte kayıt varken birleştirilmiş içerik her zaman
+ * '\n' ile biter ve tabana da öyle işlenir.
+ *
+ * @param isim Dosya yolu
+ * @param esik Günlüğün tabana işleneceği boyut (bayt)
+ * @return true Günlük açıldıysa (veya zaten açıksa), false tablo doluysa veya dosya sabitse
+ */
+bool dosya_sistemi::gunluk_ac(const char *isim, uint16_t esik)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    if (sabit_bul(isim))
+        return false;
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g)
+    {
+        g->esik = esik;
+        return true;
+    }
+    for (uint8_t i = 0; i < DEPO_GUNLUK_SAYISI && !g; i++)
+    {
+        if (_gunlukler[i].yol == 0)
+            g = &_gunlukler[i];
+    }
+    if (!g)
+        return false;
+
+    g->isim = isim;
+    g->esik = esik;
+    g->kayitlar = "";
+    g->kayitSayisi = 0;
+    g->sayildi = false;
+    g->boyut = -1;
+    g->isleniyor = false;
+
+    // Önceki çalışmadan kalan günlük bu taban için yazıldıysa yüklenir
+    String gunlukAdi = g->isim + ".jrn";
+    File gunluk = _depo.open(gunlukAdi.c_str(), "r");
+    if (gunluk)
+    {
+        File taban = _depo.open(isim, "r");
+        String baslik = String("G") + String(taban ? (unsigned long)taban.size() : 0UL);
+        if (taban)
+            taban.close();
+        if (gunluk.readStringUntil('\n') == baslik)
+        {
+            uint8_t tampon[DEPO_TAMPON];
+            size_t n;
+            while ((n = gunluk.read(tampon, sizeof(tampon))) > 0)
+                g->kayitlar.concat((const char *)tampon, n);
+        }
+        gunluk.close();
+    }
+
+    // Yarım kalmış son kayıt atılır
+    int sonKayit = g->kayitlar.lastIndexOf('\n');
+    bool yarim = (int)g->kayitlar.length() != sonKayit + 1;
+    if (yarim)
+        g->kayitlar.remove(sonKayit + 1);
+
+    gunluk_say(*g);
+    for (int i = 0; i < (int)g->kayitlar.length(); i = g->kayitlar.indexOf('\n', i) + 1)
+    {
+        g->kayitSayisi++;
+        if (g->kayitlar[i] == GUNLUK_EKLE)
+            g->satir++;
+        else if (g->kayitlar[i] == GUNLUK_SIL)
+            g->satir--;
+    }
+
+    if (yarim && g->kayitSayisi > 0)
+        gunluk_dosyasi_yaz(*g); // yarım kayıt diskten de atılır
+    else if (g->kayitSayisi == 0 && _depo.exists(gunlukAdi.c_str()))
+    {
+        uint32_t eskiBoyut = sayac_boyut(gunlukAdi.c_str());
+        _depo.remove(gunlukAdi.c_str());
+        dosya_degisti(gunlukAdi.c_str(), -(int32_t)eskiBoyut);
+    }
+
+    yol_kilidi::kritik_gir();
+    g->yol = yol_ozeti(isim);
+    _gunlukAdet++;
+    yol_kilidi::kritik_cik();
+    return true;
+}
+
+/**
+ * @brief Günlüğü tabana işler ve dosyayı günlüklü moddan çıkarır.
+ *
+ * @param isim Dosya yolu
+ * @return true Günlük açıktı ve tabana işlendi
+ */
+bool dosya_sistemi::gunluk_kapat(const char *isim)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (!g)
+        return false;
+    bool tamam = gunluk_tabana_yaz(*g);
+    yol_kilidi::kritik_gir();
+    g->yol = 0;
+    _gunlukAdet--;
+    yol_kilidi::kritik_cik();
+    g->isim = "";
+    g->kayitlar = ""; // RAM'i geri ver
+    return tamam;
+}
+
+/**
+ * @brief Günlüğü hemen tabana işler (compaction).
+ *
+ * Birleştirilmiş içerik geçici dosyaya akıtılır, günlük silinir ve geçici
+ * dosya yerine_koy() ile tabanın yerine geçer. LittleFS'te bu tek adımdır:
+ * günlük silindikten sonra ve yeniden adlandırma bitmeden güç kesilirse son
+ * düzenlemeler kaybolur, dosya bozulmaz. Hedefin üzerine yeniden adlandırma
+ * yapamayan dosya sistemlerinde taban önce silinir; arada kesilirse içerik
+ * yalnızca geçici dosyada ("/__gecici_N__.tmp") kalır.
+ *
+ * @param isim Yalnızca bu dosya; nullptr ise günlüklü tüm dosyalar
+ * @return true Tüm işlemeler başarılıysa
+ */
+bool dosya_sistemi::gunluk_sikistir(const char *isim)
+{
+    if (isim)
+    {
+        yol_kilidi kilit(isim, true);
+        gunluk_kaydi *g = gunluk_bul(isim);
+        return kilit.tamam() && (!g || gunluk_tabana_yaz(*g));
+    }
+
+    bool tamam = true;
+    for (uint8_t i = 0; i < DEPO_GUNLUK_SAYISI && _gunlukAdet > 0; i++)
+    {
+        gunluk_kaydi &g = _gunlukler[i];
+        if (g.yol == 0 || g.kayitSayisi == 0)
+            continue;
+        yol_kilidi kilit(g.isim.c_str(), true);
+        tamam &= kilit.tamam() && gunluk_tabana_yaz(g);
+    }
+    return tamam;
+}
+
+/**
+ * @brief Yolu günlük tablosunda arar.
+ *
+ * Günlüklü dosya yoksa yol özeti bile hesaplanmaz.
+ */
+dosya_sistemi::gunluk_kaydi *dosya_sistemi::gunluk_bul(const char *isim)
+{
+    if (_gunlukAdet == 0)
+        return nullptr;
+    uint32_t ozet = yol_ozeti(isim);
+    for (uint8_t i = 0; i < DEPO_GUNLUK_SAYISI; i++)
+    {
+        if (_gunlukler[i].yol == ozet && _gunlukler[i].isim == isim)
+            return &_gunlukler[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Tabanı yerinde değiştirecek bir işlemden önce günlüğü tabana işler.
+ *
+ * Okuyan işlemler çağırmaz; günlüğü birleştirerek okur. Çağıran, dosyanın
+ * yazma kilidini tutmalıdır.
+ */
+void dosya_sistemi::gunluk_isle(const char *isim)
+{
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g)
+        gunluk_tabana_yaz(*g);
+}
+
+/**
+ * @brief satir_degistir/satir_ekle/satir_sil çağrısını günlüğe yönlendirir.
+ *
+ * Birden fazla satır içeren veya eşikten uzun veri günlüğe yazılmaz; bu
+ * durumda çağıran fonksiyon günlüğü işleyip dosyayı her zamanki gibi düzenler.
+ * Günlük boşken '\n' ile bitmeyen taban dosyadaki satir_degistir de günlüksüz
+ * yapılır (bkz. gunluk_ac). Çağıran, dosyanın yazma kilidini tutmalıdır.
+ *
+ * @return int8_t 1: kaydedildi, 0: kaydedilemedi, -1: dosya günlüklü değil veya veri uygun değil
+ */
+int8_t dosya_sistemi::gunluk_duzenle(const char *isim, gunluk_turu tur, uint32_t satir, const String *veri)
+{
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (!g || (veri && (veri->indexOf('\n') >= 0 || veri->length() >= g->esik)))
+        return -1;
+    if (tur == GUNLUK_DEGISTIR && g->kayitSayisi == 0 && gunluk_say(*g) && !g->tabanSonu)
+        return -1; // dosyanın satır sonu durumunu günlüksüz yol belirler
+    return gunluk_kaydet(*g, tur, satir, veri) ? 1 : 0;
+}
+
+/**
+ * @brief Taban dosyanın satır sayısını ve '\n' ile bitip bitmediğini (gerekiyorsa) bulur.
+ *
+ * @return true Taban dosya varsa
+ */
+bool dosya_sistemi::gunluk_say(gunluk_kaydi &g)
+{
+    if (g.sayildi)
+        return g.var;
+    File dosya = _depo.open(g.isim.c_str(), "r");
+    g.var = dosya && !dosya.isDirectory();
+    g.satir = 0;
+    g.tabanSonu = true;
+    if (g.var)
+    {
+        if (dosya.size() > 0 && dosya.seek(dosya.size() - 1, SeekSet))
+            g.tabanSonu = dosya.read() == '\n';
+        dosya.seek(0, SeekSet);
+        for (const satir_gorunumu &s : satir_akisi(dosya, 0, DEPO_DOSYA_SONU))
+            g.satir += s.son;
+    }
+    else if (dosya)
+        dosya.close();
+    g.sayildi = true;
+    return g.var;
+}
+
+/**
+ * @brief Bir satır düzenlemesini günlüğe ekler.
+ *
+ * Satır numaraları günlüksüz fonksiyonlarla aynı kurala uyar: olmayan satırı
+ * değiştirmek/silmek bir şey yapmaz, dosya sonundan ilerideki ekleme sona
+ * yapılır. Günlük eşiği aşarsa hemen tabana işlenir. Çağıran, dosyanın yazma
+ * kilidini tutmalıdır.
+ *
+ * @param g Günlük kaydı
+ * @param tur GUNLUK_DEGISTIR, GUNLUK_EKLE veya GUNLUK_SIL
+ * @param satir Satır numarası (0 tabanlı)
+ * @param veri Satırın yeni içeriği (satır sonu olmadan), silmede nullptr
+ * @return true Düzenleme kaydedildiyse veya bir şey yapmıyorsa, false dosya yoksa veya yazılamadıysa
+ */
+bool dosya_sistemi::gunluk_kaydet(gunluk_kaydi &g, gunluk_turu tur, uint32_t satir, const String *veri)
+{
+    if (!gunluk_say(g))
+        return false;
+    if (tur == GUNLUK_EKLE && satir > g.satir)
+        satir = g.satir;
+    else if (tur != GUNLUK_EKLE && satir >= g.satir)
+        return true; // böyle bir satır yok
+
+    String kayit = "";
+    kayit.reserve(12 + (veri ? veri->length() : 0));
+    kayit += (char)tur;
+    kayit += String((unsigned long)satir);
+    if (veri)
+    {
+        kayit += ' ';
+        kayit += *veri;
+    }
+    kayit += '\n';
+
+    bool tamam;
+    if (g.kayitSayisi == 0)
+    {
+        g.kayitlar = kayit;
+        tamam = gunluk_dosyasi_yaz(g);
+        if (!tamam)
+            g.kayitlar = "";
+    }
+    else
+    {
+        String gunlukAdi = g.isim + ".jrn";
+        File gunluk = _depo.open(gunlukAdi.c_str(), "a");
+        tamam = gunluk && gunluk.print(kayit) == kayit.length();
+        if (gunluk)
+            gunluk.close();
+        dosya_degisti(gunlukAdi.c_str(), kayit.length());
+        if (tamam)
+            g.kayitlar += kayit;
+        else
+            gunluk_dosyasi_yaz(g); // yarım yazılan kayıt atılır
+    }
+    if (!tamam)
+        return false;
+
+    g.kayitSayisi++;
+    g.boyut = -1;
+    if (tur == GUNLUK_EKLE)
+        g.satir++;
+    else if (tur == GUNLUK_SIL)
+        g.satir--;
+
+    // Süzgeç taban dosyayı değil birleştirilmiş içeriği yansıtmalı
+    bloom_kaydi *b = bloom_bul(g.isim.c_str());
+    if (b)
+        b->eski = true;
+
+    if (g.kayitlar.length() >= g.esik)
+        return gunluk_tabana_yaz(g);
+    return true;
+}
+
+/**
+ * @brief Günlük dosyasını başlık ve RAM'deki kayıtlarla baştan yazar.
+ *
+ * @return true Tamamı yazıldıysa
+ */
+bool dosya_sistemi::gunluk_dosyasi_yaz(gunluk_kaydi &g)
+{
+    String gunlukAdi = g.isim + ".jrn";
+    uint32_t eskiBoyut = sayac_boyut(gunlukAdi.c_str());
+    File gunluk = _depo.open(gunlukAdi.c_str(), "w");
+    if (!gunluk)
+        return false;
+    File taban = _depo.open(g.isim.c_str(), "r");
+    String baslik = String("G") + String(taban ? (unsigned long)taban.size() : 0UL) + "\n";
+    if (taban)
+        taban.close();
+    bool tamam = gunluk.print(baslik) == baslik.length() && gunluk.print(g.kayitlar) == g.kayitlar.length();
+    gunluk.close();
+    dosya_degisti(gunlukAdi.c_str(), (int32_t)sayac_boyut(gunlukAdi.c_str()) - (int32_t)eskiBoyut);
+    return tamam;
+}
+
+/**
+ * @brief Günlüklü dosyanın satır aralığını, günlüğü tabanla birleştirerek verir.
+ *
+ * Günlük tabana işlenmez. Çağıran, dosyanın okuma kilidini tutmalıdır.
+ *
+ * @param isim Dosya yolu
+ * @param ilk İlk satır (0 tabanlı)
+ * @param son Son satır (dahil), DEPO_DOSYA_SONU: dosyanın sonuna kadar
+ * @param fn Her parça için çağrılır; her satır '\n' ile biter, false dönerse okuma durur
+ * @param veri `fn`e aynen geçirilen kullanıcı verisi
+ * @return int8_t 1: birleştirerek okundu, 0: okunamadı (bellek yetmedi veya taban günlük
+ *         dışında kısalmış), -1: dosya günlüklü değil veya günlük boş
+ */
+int8_t dosya_sistemi::gunluk_oku(const char *isim, uint32_t ilk, uint32_t son, aktar_fn fn, void *veri)
+{
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (!g || g->kayitSayisi == 0)
+        return -1;
+    return gunluk_birlestir(*g, ilk, son, fn, veri) < 0 ? 0 : 1;
+}
+
+/**
+ * @brief Günlük kayıtlarını taban dosyanın üzerine uygulayarak satırları verir.
+ *
+ * Satırlar günlüklü bir satir_akisi ile üretilir; her satırın sonuna '\n' eklenir.
+ *
+ * @return int8_t 1: tüm parçalar verildi, 0: `fn` durdurdu, -1: birleştirilemedi
+ */
+int8_t dosya_sistemi::gunluk_birlestir(gunluk_kaydi &g, uint32_t ilk, uint32_t son, aktar_fn fn, void *veri)
+{
+    static const uint8_t satirSonu = '\n';
+    satir_akisi akis(_depo.open(g.isim.c_str(), "r"), ilk, son, g.kayitlar, g.kayitSayisi, g.satir);
+    if (!akis.acik())
+        return -1;
+    for (const satir_gorunumu &s : akis)
+    {
+        if (!fn((const uint8_t *)s.veri, s.uzunluk, veri) || (s.son && !fn(&satirSonu, 1, veri)))
+            return 0;
+    }
+    return akis._eksik ? -1 : 1;
+}
+
+static bool bayt_say(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    (void)parca;
+    *(uint32_t *)veri += uzunluk;
+    return true;
+}
+
+/**
+ * @brief Günlük uygulanmış içeriğin boyutunu verir.
+ *
+ * Boyut bir kez birleştirerek sayılır ve sonraki kayda kadar saklanır.
+ * Çağıran, dosyanın okuma kilidini tutmalıdır.
+ *
+ * @return int32_t Boyut (bayt), birleştirilemezse -1
+ */
+int32_t dosya_sistemi::gunluk_boyut(gunluk_kaydi &g)
+{
+    if (g.boyut < 0)
+    {
+        uint32_t toplam = 0;
+        if (gunluk_birlestir(g, 0, DEPO_DOSYA_SONU, bayt_say, &toplam) == 1)
+            g.boyut = toplam;
+    }
+    return g.boyut;
+}
+
+/**
+ * @brief Günlüklü dosya için birleştiren bir satır akışı kurar.
+ *
+ * Kayıtlar kopyalanıp bir kez çözülür (kayıt başına 12 bayt); böylece akış
+ * kilit tutulmadan dolaşılırken yapılan düzenlemeler akışı bozmaz.
+ *
+ * @param dosya Taban dosya
+ * @param ilk İlk birleştirilmiş satır
+ * @param son Son birleştirilmiş satır (dahil)
+ * @param kayitlar Günlük kayıtları (başlık hariç)
+ * @param adet Kayıt sayısı
+ * @param satirSayisi Birleştirilmiş içeriğin satır sayısı
+ */
+satir_akisi::satir_akisi(File dosya, uint32_t ilk, uint32_t son, const String &kayitlar, uint16_t adet,
+                         uint32_t satirSayisi)
+    : _dosya(dosya), _ilk(0), _son(0), _acik(dosya && !dosya.isDirectory()), _kayitlar(kayitlar), _cikis(ilk),
+      _cikisBitis(son < satirSayisi ? son + 1 : satirSayisi)
+{
+    _kayit = (gunluk_parcasi *)malloc(adet * sizeof(gunluk_parcasi) + 1);
+    if (!_kayit || _kayitlar.length() != kayitlar.length())
+    {
+        _acik = false;
+        return;
+    }
+    const char *metin = _kayitlar.c_str();
+    for (int i = 0; i < (int)_kayitlar.length() && _kayitAdet < adet; _kayitAdet++)
+    {
+        gunluk_parcasi &k = _kayit[_kayitAdet];
+        char *sayiSonu;
+        k.tur = metin[i];
+        k.satir = strtoul(metin + i + 1, &sayiSonu, 10);
+        int satirSonu = _kayitlar.indexOf('\n', i);
+        k.bas = sayiSonu - metin + (*sayiSonu == ' ' ? 1 : 0);
+        k.uzunluk = satirSonu - k.bas;
+        i = satirSonu + 1;
+    }
+}
+
+/**
+ * @brief Sıradaki birleştirilmiş satırı (veya parçasını) hazırlar.
+ *
+ * Satır kayıtlar sondan başa dolaşılarak ya bir kayda ya da taban satırına
+ * çevrilir. Taban satırları artan sırayla istendiği için taban dosya yalnızca
+ * ileri doğru bir kez okunur.
+ */
+bool satir_akisi::gunlukten_ilerle()
+{
+    if (!_acik)
+        return false;
+    if (!_tabanda)
+    {
+        if (_cikis >= _cikisBitis)
+        {
+            _dosya.close();
+            _acik = false;
+            return false;
+        }
+
+        // Satırı son kayıttan ilkine doğru çevir
+        uint32_t tabanSatir = _cikis;
+        for (int32_t i = (int32_t)_kayitAdet - 1; i >= 0; i--)
+        {
+            const gunluk_parcasi &k = _kayit[i];
+            if (k.tur == GUNLUK_SIL)
+            {
+                if (tabanSatir >= k.satir)
+                    tabanSatir++;
+            }
+            else if (tabanSatir == k.satir)
+            {
+                _gorunum.veri = _kayitlar.c_str() + k.bas;
+                _gorunum.uzunluk = k.uzunluk;
+                _gorunum.no = _cikis++;
+                _gorunum.bas = true;
+                _gorunum.son = true;
+                return true;
+            }
+            else if (k.tur == GUNLUK_EKLE && tabanSatir > k.satir)
+                tabanSatir--;
+        }
+        _ilk = _son = tabanSatir;
+    }
+
+    if (!dosyadan_ilerle())
+    {
+        _eksik = true; // taban beklenenden kısa (günlük dışında değişmiş)
+        return false;
+    }
+    _gorunum.no = _cikis;
+    _tabanda = !_gorunum.son;
+    if (_gorunum.son)
+        _cikis++;
+    return true;
+}
+
+/**
+ * @brief Günlüğü tabana işler.
+ *
+ * Taban dosyanın yerine yenisi konduğu için çağıran, dosyanın yazma kilidini
+ * tutmalıdır. Yazılamazsa günlük olduğu gibi kalır. Yeni taban yerine
+ * konamaz ama eski taban yerindeyse silinen günlük RAM'deki kayıtlardan
+ * yeniden yazılır.
+ *
+ * @return true Günlük boştu veya başarıyla işlendi
+ */
+bool dosya_sistemi::gunluk_tabana_yaz(gunluk_kaydi &g)
+{
+    if (g.kayitSayisi == 0)
+        return true;
+    g.isleniyor = true;
+
+    const char *isim = g.isim.c_str();
+    String geciciIsim = gecici_isim();
+    File yeni = _depo.open(geciciIsim.c_str(), "w");
+    bool tamam = (bool)yeni;
+    if (tamam)
+    {
+        tamam = gunluk_birlestir(g, 0, DEPO_DOSYA_SONU, dosyaya_yaz, &yeni) == 1;
+        yeni.close();
+    }
+
+    if (tamam)
+    {
+        // Önce günlük silinir: yarıda kesilirse günlük eski tabana uygulanmaz.
+        // Boyutlar boyut() ile alınmaz; boyut() günlüklü dosyada buraya döner.
+        String gunlukAdi = g.isim + ".jrn";
+        int32_t gunlukBoyutu = sayac_boyut(gunlukAdi.c_str());
+        File dosya = _depo.open(isim, "r");
+        int32_t eskiBoyut = dosya ? dosya.size() : 0;
+        if (dosya)
+            dosya.close();
+        dosya = _depo.open(geciciIsim.c_str(), "r");
+        int32_t yeniBoyut = dosya ? dosya.size() : 0;
+        if (dosya)
+            dosya.close();
+        _depo.remove(gunlukAdi.c_str());
+        dosya_degisti(gunlukAdi.c_str(), -gunlukBoyutu);
+        tamam = yerine_koy(geciciIsim.c_str(), isim);
+        if (tamam)
+        {
+            dosya_degisti(isim, yeniBoyut - eskiBoyut);
+            g.kayitlar = "";
+            g.kayitSayisi = 0;
+        }
+        else if (_depo.exists(isim))
+            gunluk_dosyasi_yaz(g);
+    }
+    else
+        _depo.remove(geciciIsim.c_str());
+
+    g.isleniyor = false;
+    return tamam;
+}
@@ -3,16 +3,24 @@
 /**
  * @brief Dosya sistemini başlatır.
  * 
- * Bu fonksiyon LittleFS dosya sistemini başlatmayı dener.
+ * Bu fonksiyon nesnenin bağlı olduğu dosya sistemini (varsayılan LittleFS,
+ * kurucuya SDFS gibi başka bir fs::FS de verilebilir) başlatmayı dener.
  * Başarılı olursa true döner, aksi takdirde false.
  * Genelde setup() içinde bir kere çağrılır.
+ * ESP32'de fs::FS begin() sunmaz; orada yalnızca LittleFS burada başlatılır,
+ * başka bir dosya sistemini çağıran taraf önceden başlatmış olmalıdır.
  * 
  * @return true  - Başlatma başarılı
  * @return false - Başlatma başarısız
  */
 bool dosya_sistemi::kur()
 {
-    if (!LittleFS.begin())
+#ifdef ESP32
+    bool basladi = &_depo != &LittleFS || LittleFS.begin();
+#else
+    bool basladi = _depo.begin();
+#endif
+    if (!basladi)
     {
         Serial.print(F("\nLittleFS baslatilamadi!\n"));
         return false;
@@ -29,16 +37,27 @@ bool dosya_sistemi::kur()
  * @return false Dosya yoksa
  */
 bool dosya_sistemi::var_mi(const char* isim) {
-    return LittleFS.exists(isim);
+    yol_kilidi kilit(isim, false);
+    int32_t sabitBoyut;
+    if (sabitten_oku(isim, nullptr, &sabitBoyut))
+        return sabitBoyut >= 0;
+    return _depo.exists(isim);
 }
 
 /**
  * @brief Dosya sistemini kapatır.
  * 
- * LittleFS'i sonlandırır. Genellikle sistem kapatılmadan önce çağrılır.
+ * Bağlı dosya sistemini (varsayılan LittleFS) sonlandırır. Genellikle sistem kapatılmadan önce çağrılır.
  */
 void dosya_sistemi::kapat() {
-    LittleFS.end();
+    diske_aktar(); // sabit dosyalardaki aktarılmamış yazmalar
+    gunluk_sikistir();
+#ifdef ESP32
+    if (&_depo == &LittleFS)
+        LittleFS.end();
+#else
+    _depo.end();
+#endif
     Serial.println(F("LittleFS kapatildi"));
 }
 
@@ -50,12 +69,15 @@ void dosya_sistemi::kapat() {
  * @return false Dosya oluşturulamadı
  */
 bool dosya_sistemi::olustur(const char* isim) {
-    if (LittleFS.exists(isim)) {
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam()) return false;
+    if (var_mi(isim)) {
         return true; // Zaten var
     }
-    File dosya = LittleFS.open(isim, "w");
+    File dosya = _depo.open(isim, "w");
     if (!dosya) return false;
     dosya.close();
+    dosya_degisti(isim, 0);
     return true;
 }
 
@@ -63,13 +85,19 @@ bool dosya_sistemi::olustur(const char* isim) {
 /**
  * @brief Belirtilen dosyanın boyutunu döndürür.
  * 
- * Dosya başarıyla açılırsa, bayt cinsinden boyutunu döndürür.
+ * Dosya başarıyla açılırsa, bayt cinsinden boyutunu döndürür. Günlüklü
+ * dosyada günlük uygulanmış içeriğin boyutu döner.
  * 
  * @param isim Dosyanın yolu
  * @return int32_t Dosya boyutu (bayt), dosya açılamazsa -1
  */
 int32_t dosya_sistemi::boyut(const char* isim) {
-    File dosya = LittleFS.open(isim, "r");
+    yol_kilidi kilit(isim, false);
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0) return gunluk_boyut(*g);
+    int32_t sabitBoyut;
+    if (sabitten_oku(isim, nullptr, &sabitBoyut)) return sabitBoyut;
+    File dosya = _depo.open(isim, "r");
     if (!dosya) return -1;
     int32_t size = dosya.size();
     dosya.close();
@@ -84,9 +112,13 @@ int32_t dosya_sistemi::boyut(const char* isim) {
  */
 void dosya_sistemi::boyut()
 {
-    FSInfo fs_info;
-    LittleFS.info(fs_info);
-    float usedPercentage = (float(fs_info.usedBytes) / float(fs_info.totalBytes)) * 100;
+    size_t toplam, kullanilan;
+    if (!kapasite(toplam, kullanilan))
+    {
+        Serial.print(F("Depolama bilgisi alinamadi\n"));
+        return;
+    }
+    float usedPercentage = (float(kullanilan) / float(toplam)) * 100;
     Serial.print(F("Kullanılan depolama boyutu: %") + String(usedPercentage) + "\n");
 }
 
@@ -95,23 +127,29 @@ void dosya_sistemi::boyut()
  * 
  * Toplam kapasite, kullanılan alan, boş alan, blok boyutu, 
  * sayfa boyutu, açık dosya limiti gibi bilgileri detaylı olarak yazdırır.
+ * ESP32'de blok/sayfa boyutu ve limitler alınamadığı için yalnızca
+ * kapasite satırları yazdırılır.
  */
 void dosya_sistemi::boyut_genel_ayrintili()
 {
-    FSInfo info;
-    LittleFS.info(info);
-    size_t bosAlan = info.totalBytes - info.usedBytes;
+    size_t toplam, kullanilan;
+    if (!kapasite(toplam, kullanilan))
+    {
+        Serial.print(F("Depolama bilgisi alinamadi\n"));
+        return;
+    }
+    size_t bosAlan = toplam - kullanilan;
     float oran_toplam = 100.0;
-    float oran_kullanilan = ((float)info.usedBytes / info.totalBytes) * 100.0;
-    float oran_bos = ((float)bosAlan / info.totalBytes) * 100.0;
+    float oran_kullanilan = ((float)kullanilan / toplam) * 100.0;
+    float oran_bos = ((float)bosAlan / toplam) * 100.0;
     Serial.print(F("===== LittleFS Dosya Sistemi Bilgisi =====\n"));
     Serial.print(F("Toplam kapasite (flash'ta ayrılan alan)    : "));
-    Serial.print(info.totalBytes);
+    Serial.print(toplam);
     Serial.print(F(" bayt (%"));
     Serial.print(oran_toplam);
     Serial.print(F(")\n"));
     Serial.print(F("Kullanılan alan                           : "));
-    Serial.print(info.usedBytes);
+    Serial.print(kullanilan);
     Serial.print(F(" bayt (%"));
     Serial.print(oran_kullanilan);
     Serial.print(F(")\n"));
@@ -120,6 +158,9 @@ void dosya_sistemi::boyut_genel_ayrintili()
     Serial.print(F(" bayt (%"));
     Serial.print(oran_bos);
     Serial.print(F(")\n"));
+#ifndef ESP32
+    FSInfo info;
+    _depo.info(info);
     Serial.print(F("Flash blok (silme) boyutu                 : "));
     Serial.print(info.blockSize);
     Serial.print(F(" bayt\n"));
@@ -132,6 +173,7 @@ void dosya_sistemi::boyut_genel_ayrintili()
     Serial.print(F("Maksimum dosya yolu uzunluğu              : "));
     Serial.print(info.maxPathLength);
     Serial.print(F(" karakter\n"));
+#endif
     Serial.print(F("===========================================\n"));
 }
 
@@ -146,7 +188,7 @@ void dosya_sistemi::boyut_genel_ayrintili()
  */
 void dosya_sistemi::listele(const char *dizinYolu, int seviye)
 {
-    File klasor = LittleFS.open(dizinYolu, "r");
+    File klasor = _depo.open(dizinYolu, "r");
     if (!klasor || !klasor.isDirectory())
     {
         Serial.print(F("HATA: Geçerli klasör açılamadı: "));
@@ -195,29 +237,474 @@ void dosya_sistemi::listele_tumicerik()
 /**
  * @brief Belirtilen dosyadaki satır sayısını sayar.
  * 
- * Dosya açılır ve içindeki tüm karakterler taranır.
- * Her `\n` karakteri yeni bir satır olarak kabul edilir.
+ * Dosya DEPO_TAMPON boyutlu bloklar halinde taranır.
+ * Her `\n` karakteri bir satırı bitirir. Sonunda `\n` olmayan son satır da
+ * sayılır; böylece sonuç satir_oku() ile okunabilen satır sayısına eşittir.
+ * RAM'e sabitlenmiş dosyada satırlar RAM kopyasında sayılır.
  * 
  * @param isim Satır sayısı hesaplanacak dosyanın yolu
- * @return int16_t - Satır sayısı (başarılıysa), -1 (dosya açılamazsa)
+ * @return int32_t - Satır sayısı (başarılıysa), -1 (dosya açılamazsa)
  */
-int16_t dosya_sistemi::satir_hesap(const char *isim)
+int32_t dosya_sistemi::satir_hesap(const char *isim)
 {
-    File dosya = LittleFS.open(isim, "r");
+    yol_kilidi kilit(isim, false);
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0)
+        return g->satir; // günlük her düzenlemede satır sayısını günceller
+    int32_t sabitSatir = sabit_satir_sayisi(isim);
+    if (sabitSatir >= 0)
+        return sabitSatir;
+    File dosya = _depo.open(isim, "r");
     if (!dosya || dosya.isDirectory())
     {
         Serial.print(F("Dosya veya klasor acilamadi"));
         return -1; // hata
     }
-    int16_t satirSayisi = 0;
+    int32_t satirSayisi = 0;
+    uint8_t tampon[DEPO_TAMPON];
+    uint8_t son = '\n';
     while (dosya.available())
     {
-        char karakter = dosya.read();
-        if (karakter == '\n')
+        size_t n = dosya.read(tampon, sizeof(tampon));
+        if (n == 0)
+            break;
+        for (size_t i = 0; i < n; i++)
         {
-            satirSayisi++;
+            if (tampon[i] == '\n')
+                satirSayisi++;
         }
+        son = tampon[n - 1];
     }
+    if (son != '\n')
+        satirSayisi++; // sonunda satır sonu olmayan son satır
     dosya.close();
     return satirSayisi;
 }
+
+/**
+ * @brief Klasör yolu ile girdinin adını birleştirir.
+ *
+ * Bazı çekirdeklerde name() tam yolu, bazılarında yalnızca dosya adını döndürür.
+ * İki durumda da tam yol elde edilir.
+ */
+static String tam_yol(const String &dizin, const char *ad)
+{
+    if (ad[0] == '/')
+        return String(ad);
+    if (dizin.endsWith("/"))
+        return dizin + ad;
+    return dizin + "/" + ad;
+}
+
+/**
+ * @brief Bir klasör ağacını özyineleme kullanmadan dolaşır.
+ *
+ * Her dosya ve klasör için `fn` çağrılır. Açık klasörler sabit boyutlu bir yığında
+ * tutulur, bu yüzden yığın (stack) kullanımı ağacın büyüklüğünden bağımsızdır.
+ * DEPO_MAX_DERINLIK'ten daha derin klasörlere inilmez.
+ * `fn` false döndürürse dolaşma hemen durdurulur.
+ *
+ * @param kok Dolaşmaya başlanacak klasör (örn: "/")
+ * @param fn Her girdi için çağrılacak fonksiyon (yol, klasör mü, boyut, derinlik, veri)
+ * @param veri fn'e aynen iletilen kullanıcı verisi
+ * @return true  - Kök klasör açıldı
+ * @return false - Kök klasör açılamadı
+ */
+bool dosya_sistemi::dolas(const char *kok, dolas_fn fn, void *veri)
+{
+    File yigin[DEPO_MAX_DERINLIK];
+    String yollar[DEPO_MAX_DERINLIK];
+
+    yigin[0] = _depo.open(kok, "r");
+    if (!yigin[0] || !yigin[0].isDirectory())
+    {
+        Serial.print(F("HATA: Geçerli klasör açılamadı: "));
+        Serial.print(kok);
+        Serial.print(F("\n"));
+        return false;
+    }
+    yollar[0] = kok;
+
+    int8_t seviye = 0;
+    while (seviye >= 0)
+    {
+        File girdi = yigin[seviye].openNextFile();
+        if (!girdi)
+        {
+            yigin[seviye].close();
+            yollar[seviye] = "";
+            seviye--;
+            continue;
+        }
+
+        String yol = tam_yol(yollar[seviye], girdi.name());
+        bool dizin = girdi.isDirectory();
+        uint32_t bayt = dizin ? 0 : girdi.size();
+
+        if (!fn(yol, dizin, bayt, seviye + 1, veri))
+        {
+            girdi.close();
+            while (seviye >= 0)
+                yigin[seviye--].close();
+            return true;
+        }
+
+        if (dizin && seviye + 1 < DEPO_MAX_DERINLIK)
+        {
+            seviye++;
+            yigin[seviye] = girdi;
+            yollar[seviye] = yol;
+        }
+        else
+            girdi.close();
+    }
+    return true;
+}
+
+struct kullanim_durumu
+{
+    dizin_kullanim *dizinler;
+    uint16_t maxDizin;
+    uint16_t adet;
+    int16_t atalar[DEPO_MAX_DERINLIK + 1];
+};
+
+static void buyuklere_ekle(dizin_kullanim &d, const String &yol, uint32_t bayt)
+{
+    for (uint8_t i = 0; i < DEPO_BUYUK_DOSYA; i++)
+    {
+        if (d.en_buyukler[i].yol.length() == 0 || bayt > d.en_buyukler[i].bayt)
+        {
+            for (uint8_t j = DEPO_BUYUK_DOSYA - 1; j > i; j--)
+                d.en_buyukler[j] = d.en_buyukler[j - 1];
+            d.en_buyukler[i].yol = yol;
+            d.en_buyukler[i].bayt = bayt;
+            return;
+        }
+    }
+}
+
+static bool kullanim_topla(const String &yol, bool dizin, uint32_t bayt, uint8_t derinlik, void *veri)
+{
+    kullanim_durumu *d = (kullanim_durumu *)veri;
+
+    // Girdiyi tüm üst klasörlerin toplamına ekle
+    if (!dizin)
+    {
+        for (uint8_t i = 0; i < derinlik; i++)
+        {
+            int16_t ata = d->atalar[i];
+            if (ata < 0)
+                continue;
+            d->dizinler[ata].bayt += bayt;
+            d->dizinler[ata].dosya_sayisi++;
+            buyuklere_ekle(d->dizinler[ata], yol, bayt);
+        }
+        return true;
+    }
+
+    if (d->adet >= d->maxDizin)
+    {
+        d->atalar[derinlik] = -1; // yer kalmadı, içeriği üst klasörlere yazılır
+        return true;
+    }
+
+    dizin_kullanim &yeni = d->dizinler[d->adet];
+    yeni = dizin_kullanim();
+    yeni.yol = yol;
+    yeni.derinlik = derinlik;
+    for (int8_t i = derinlik - 1; i >= 0; i--)
+    {
+        if (d->atalar[i] >= 0)
+        {
+            yeni.ust = d->atalar[i];
+            break;
+        }
+    }
+    d->atalar[derinlik] = d->adet++;
+    return true;
+}
+
+/**
+ * @brief Klasör bazında disk kullanımını tek geçişte hesaplar.
+ *
+ * Ağaç dolas() ile bir kez gezilir. Her klasör için alt klasörler dahil toplam bayt,
+ * dosya sayısı ve en büyük DEPO_BUYUK_DOSYA dosya `dizinler` dizisine yazılır.
+ * İlk kayıt her zaman kök klasördür. Dizide yer kalmazsa fazla klasörlerin
+ * içeriği en yakın kayıtlı üst klasöre eklenir.
+ *
+ * @param kok Hesaplamanın başlayacağı klasör
+ * @param dizinler Sonuçların yazılacağı dizi
+ * @param maxDizin Dizinin eleman sayısı
+ * @return int16_t Doldurulan kayıt sayısı, kök açılamazsa -1
+ */
+int16_t dosya_sistemi::kullanim_agaci(const char *kok, dizin_kullanim *dizinler, uint16_t maxDizin)
+{
+    if (maxDizin == 0)
+        return -1;
+
+    kullanim_durumu durum;
+    durum.dizinler = dizinler;
+    durum.maxDizin = maxDizin;
+    durum.adet = 1;
+    dizinler[0] = dizin_kullanim();
+    dizinler[0].yol = kok;
+    for (uint8_t i = 0; i <= DEPO_MAX_DERINLIK; i++)
+        durum.atalar[i] = -1;
+    durum.atalar[0] = 0;
+
+    if (!dolas(kok, kullanim_topla, &durum))
+        return -1;
+    return durum.adet;
+}
+
+/**
+ * @brief Klasör bazında disk kullanımını seri porta yazdırır.
+ *
+ * kullanim_agaci() sonucunu girintili olarak listeler. Hangi klasörün
+ * flash'ı doldurduğunu bulmak için kullanılır.
+ *
+ * @param kok Listelenecek klasör (varsayılan "/")
+ */
+void dosya_sistemi::kullanim_listele(const char *kok)
+{
+    dizin_kullanim dizinler[DEPO_KULLANIM_MAX_DIZIN];
+    int16_t adet = kullanim_agaci(kok, dizinler, DEPO_KULLANIM_MAX_DIZIN);
+    if (adet < 0)
+        return;
+
+    Serial.print(F("===== Klasör Kullanımı =====\n"));
+    for (int16_t i = 0; i < adet; i++)
+    {
+        for (uint8_t s = 0; s < dizinler[i].derinlik; s++)
+            Serial.print(F("  "));
+        Serial.print(F("[Klasör] "));
+        Serial.print(dizinler[i].yol);
+        Serial.print(F(" - "));
+        Serial.print(dizinler[i].bayt);
+        Serial.print(F(" bayt, "));
+        Serial.print(dizinler[i].dosya_sayisi);
+        Serial.print(F(" dosya\n"));
+        for (uint8_t b = 0; b < DEPO_BUYUK_DOSYA; b++)
+        {
+            if (dizinler[i].en_buyukler[b].yol.length() == 0)
+                break;
+            for (uint8_t s = 0; s <= dizinler[i].derinlik; s++)
+                Serial.print(F("  "));
+            Serial.print(F("* "));
+            Serial.print(dizinler[i].en_buyukler[b].yol);
+            Serial.print(F(" - "));
+            Serial.print(dizinler[i].en_buyukler[b].bayt);
+            Serial.print(F(" bayt\n"));
+        }
+    }
+    Serial.print(F("============================\n"));
+}
+
+/**
+ * @brief Kullanılan alan sayacını başlatır (veya yeniden eşitler).
+ *
+ * Başlangıç değeri kapasite() ile alınır. Sonrasında kütüphanenin kendi
+ * yazma, ekleme ve silme fonksiyonları sayacı bayt farkı kadar günceller.
+ * Böylece bos_alan() her çağrıda dosya sistemini sorgulamaz.
+ * Sayaç blok yuvarlamasını izlemediği için yaklaşıktır; ara sıra bu fonksiyon
+ * tekrar çağrılarak gerçek değere eşitlenebilir.
+ *
+ * @return true  - Sayaç başlatıldı
+ * @return false - Dosya sistemi bilgisi alınamadı
+ */
+bool dosya_sistemi::kullanim_sayaci_ac()
+{
+    size_t toplam, kullanilan;
+    if (!kapasite(toplam, kullanilan))
+        return false;
+    _toplamBayt = toplam;
+    _kullanilanBayt = kullanilan;
+    _sayacAktif = true;
+    return true;
+}
+
+/**
+ * @brief Kullanılan alan sayacını kapatır.
+ *
+ * Sonraki bos_alan() çağrıları tekrar kapasite() kullanır.
+ */
+void dosya_sistemi::kullanim_sayaci_kapat()
+{
+    _sayacAktif = false;
+}
+
+/**
+ * @brief Boş alanı bayt olarak döndürür.
+ *
+ * Sayaç açıksa hiçbir dosya sistemi çağrısı yapılmaz.
+ *
+ * @return int32_t Boş alan (bayt), bilgi alınamazsa -1
+ */
+int32_t dosya_sistemi::bos_alan()
+{
+    if (_sayacAktif)
+        return _kullanilanBayt >= _toplamBayt ? 0 : _toplamBayt - _kullanilanBayt;
+
+    size_t toplam, kullanilan;
+    if (!kapasite(toplam, kullanilan))
+        return -1;
+    return toplam - kullanilan;
+}
+
+/**
+ * @brief Dosya sisteminin toplam ve kullanılan baytını alır.
+ *
+ * ESP8266'da her fs::FS info() ile bunu bildirir. ESP32'de fs::FS'in böyle
+ * bir üyesi yoktur; kapasite yalnızca LittleFS için (totalBytes/usedBytes)
+ * alınabilir, başka bir dosya sisteminde false döner.
+ *
+ * @param toplam Toplam bayt
+ * @param kullanilan Kullanılan bayt
+ * @return true  - Bilgi alındı
+ * @return false - Bilgi alınamadı
+ */
+bool dosya_sistemi::kapasite(size_t &toplam, size_t &kullanilan)
+{
+#ifdef ESP32
+    if (&_depo != &LittleFS)
+        return false;
+    toplam = LittleFS.totalBytes();
+    kullanilan = LittleFS.usedBytes();
+    return true;
+#else
+    FSInfo info;
+    if (!_depo.info(info))
+        return false;
+    toplam = info.totalBytes;
+    kullanilan = info.usedBytes;
+    return true;
+#endif
+}
+
+/**
+ * @brief Sayaç açıksa dosyanın flash'taki şu anki boyutunu döndürür.
+ *
+ * Sayaç kapalıyken dosya hiç açılmaz ve 0 döner; böylece
+ * sayaç kullanılmadığında yazma yollarına ek maliyet gelmez. Sayaç flash
+ * kullanımını izlediği için boyut() yerine dosyanın kendisine bakılır:
+ * sabit dosyanın RAM kopyası ve günlük hesaba katılmaz.
+ */
+uint32_t dosya_sistemi::sayac_boyut(const char *isim)
+{
+    if (!_sayacAktif)
+        return 0;
+    File dosya = _depo.open(isim, "r");
+    if (!dosya)
+        return 0;
+    uint32_t b = dosya.isDirectory() ? 0 : dosya.size();
+    dosya.close();
+    return b;
+}
+
+/**
+ * @brief Bir dosyanın içeriği değiştiğinde çağrılır.
+ *
+ * Kullanılan alan sayacını günceller, dosyanın içerik özetini siler,
+ * dosya RAM'e sabitlenmişse kopyasını yeniden yükler, Bloom süzgecini eskitir
+ * ve (günlük işlenmiyorsa) dosyanın satır düzenleme günlüğünü atar.
+ *
+ * @param isim Değişen dosyanın yolu
+ * @param fark Dosya boyutundaki değişim (bayt)
+ */
+void dosya_sistemi::dosya_degisti(const char *isim, int32_t fark)
+{
+    // Sabit dosya önbellek dışında değişti: RAM kopyası flash'tan yenilenir
+    sabit_kaydi *s = sabit_bul(isim);
+    if (s && !s->aktariliyor)
+        sabit_yenile(*s);
+
+    // Bloom süzgeci eskidi; sabit dosyanın aktarılması içeriği değiştirmez
+    bloom_kaydi *b = bloom_bul(isim);
+    if (b && !(s && s->aktariliyor))
+        b->eski = true;
+
+    // Günlüklü dosya günlük dışında yazıldı: kayıtlar eski içeriğe aitti
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && !g->isleniyor)
+    {
+        if (g->kayitSayisi > 0)
+        {
+            String gunlukAdi = g->isim + ".jrn";
+            int32_t gunlukBoyutu = sayac_boyut(gunlukAdi.c_str());
+            _depo.remove(gunlukAdi.c_str());
+            dosya_degisti(gunlukAdi.c_str(), -gunlukBoyutu);
+            g->kayitlar = "";
+            g->kayitSayisi = 0;
+        }
+        g->sayildi = false;
+    }
+
+    // Bilinen içerik özeti artık geçersiz
+    uint32_t ozet = yol_ozeti(isim);
+    yol_kilidi::kritik_gir();
+    for (uint8_t i = 0; i < DEPO_OZET_SAYISI; i++)
+    {
+        if (_ozetler[i].yol == ozet)
+            _ozetler[i].yol = 0;
+    }
+    yol_kilidi::kritik_cik();
+
+    if (!_sayacAktif)
+        return;
+    yol_kilidi::kritik_gir();
+    if (fark < 0 && (uint32_t)(-fark) > _kullanilanBayt)
+        _kullanilanBayt = 0;
+    else
+        _kullanilanBayt += fark;
+    yol_kilidi::kritik_cik();
+}
+
+/**
+ * @brief CRC-32 (IEEE 802.3) hesaplar.
+ *
+ * 16 elemanlı tablo ile yarım bayt (nibble) bazında çalışır; flash'ta
+ * yalnızca 64 bayt yer kaplar. Büyük veriler parça parça verilebilir:
+ * her çağrıya bir önceki sonuç `onceki` olarak geçilir.
+ *
+ * @param veri Hesaplanacak veri
+ * @param uzunluk Veri uzunluğu (bayt)
+ * @param onceki Önceki parçanın CRC değeri (ilk parça için 0)
+ * @return uint32_t CRC-32 değeri
+ */
+uint32_t dosya_sistemi::crc32(const void *veri, size_t uzunluk, uint32_t onceki)
+{
+    static const uint32_t tablo[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+
+    const uint8_t *p = (const uint8_t *)veri;
+    uint32_t crc = ~onceki;
+    while (uzunluk--)
+    {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ tablo[crc & 0x0F];
+        crc = (crc >> 4) ^ tablo[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Dosya yolunun 32 bitlik özetini (FNV-1a) hesaplar.
+ *
+ * Kilit yuvası seçimi ve içerik özeti tablosu gibi heap kullanmadan
+ * yol tutması gereken yerlerde kullanılır. Hiçbir zaman 0 döndürmez.
+ *
+ * @param isim Dosya yolu
+ * @return uint32_t Yol özeti
+ */
+uint32_t dosya_sistemi::yol_ozeti(const char *isim)
+{
+    uint32_t h = 2166136261UL;
+    while (*isim)
+    {
+        h ^= (uint8_t)*isim++;
+        h *= 16777619UL;
+    }
+    return h ? h : 1;
+}
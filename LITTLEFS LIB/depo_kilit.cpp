@@ -0,0 +1,223 @@
+#include "LITTLEFS_LIB.h"
+
+/**
+ * @brief Her işlem için ayrı bir geçici dosya adı üretir.
+ *
+ * Aynı anda çalışan iki düzenleme işleminin aynı geçici dosyayı
+ * kullanıp birbirinin içeriğini bozmasını önler.
+ *
+ * @return String Örneğin "/__gecici_3__.tmp"
+ */
+String dosya_sistemi::gecici_isim()
+{
+    yol_kilidi::kritik_gir();
+    uint16_t no = _geciciSayac++;
+    yol_kilidi::kritik_cik();
+    return String(F("/__gecici_")) + String(no) + F("__.tmp");
+}
+
+/**
+ * @brief Tamamlanmış geçici dosyayı asıl dosyanın yerine koyar.
+ *
+ * Önce doğrudan yeniden adlandırılır; LittleFS var olan hedefi tek adımda
+ * değiştirir, güç kesilse de dosyanın ya eski ya yeni hali kalır. Hedefin
+ * üzerine yeniden adlandırmaya izin vermeyen dosya sistemlerinde hedef önce
+ * silinir; bu iki adım arasında kesilirse içerik geçici dosyada kalır.
+ * Başarısızlıkta hata yazdırılır. Asıl dosya yerinde kaldıysa geçici dosya
+ * silinir; silindiyse içerik kaybolmasın diye geçici dosya bırakılır.
+ *
+ * @param gecici Geçici dosya yolu
+ * @param isim Yerine konacak dosya yolu
+ * @return true Geçici dosya artık `isim` adını taşıyorsa
+ */
+bool dosya_sistemi::yerine_koy(const char *gecici, const char *isim)
+{
+    if (_depo.rename(gecici, isim))
+        return true;
+    int32_t eskiBoyut = sayac_boyut(isim);
+    _depo.remove(isim);
+    if (_depo.rename(gecici, isim))
+        return true;
+
+    Serial.print(F("Dosya yerine konamadi: "));
+    Serial.print(isim);
+    if (_depo.exists(isim))
+        _depo.remove(gecici);
+    else
+    {
+        dosya_degisti(isim, -eskiBoyut);
+        Serial.print(F(" (icerik: "));
+        Serial.print(gecici);
+        Serial.print(F(")"));
+    }
+    Serial.print(F("\n"));
+    return false;
+}
+
+#if DEPO_KILITLI
+
+struct kilit_yuvasi
+{
+    TaskHandle_t sahip;   // yazma kilidini tutan görev
+    uint8_t derinlik;     // sahibin iç içe aldığı kilit sayısı
+    uint16_t okuyucu;     // okuma kilidini tutan görev sayısı
+};
+
+static kilit_yuvasi yuvalar[DEPO_KILIT_SAYISI];
+static portMUX_TYPE depo_mux = portMUX_INITIALIZER_UNLOCKED;
+static thread_local uint8_t okunanlar[DEPO_KILIT_SAYISI]; // bu görevin yuva başına tuttuğu okuma kilidi
+
+/**
+ * @brief Dosya yolunu bir kilit yuvasına eşler.
+ */
+static uint8_t yuva_no(const char *isim)
+{
+    return dosya_sistemi::yol_ozeti(isim) % DEPO_KILIT_SAYISI;
+}
+
+void yol_kilidi::kritik_gir()
+{
+    portENTER_CRITICAL(&depo_mux);
+}
+
+void yol_kilidi::kritik_cik()
+{
+    portEXIT_CRITICAL(&depo_mux);
+}
+
+/**
+ * @brief Çağıran görev bu yolun yuvasında okuma kilidi tutuyor mu?
+ *
+ * Okuma kilidi yazmaya yükseltilemez (diğer okuyucuları, dolayısıyla kendini
+ * bekler). Dosyayı gerekirse yazma kilidiyle değiştirecek yardımcılar bunu
+ * sorarak iç içe okuma altında değişikliği atlar.
+ */
+bool yol_kilidi::okuyor(const char *isim)
+{
+    return okunanlar[yuva_no(isim)] > 0;
+}
+
+/**
+ * @brief Bir yuvada okuma veya yazma kilidi alır.
+ *
+ * Aynı dosyayı okuyanlar birbirini beklemez; yazan tektir ve okuyucular
+ * bitene kadar bekler. Yazma kilidini tutan görev aynı yuvada tekrar kilit
+ * isterse (örn. satir_sil içinden yaz çağrısı) beklemeden devam eder.
+ * Bu durumda istenen okuma kilidi iç içe yazma kilidi olarak sayılır.
+ *
+ * Okuma kilidi tutan görev aynı yuvada yazma kilidi isterse (örn. aktar()
+ * geri çağrısından yaz) kendi okumasının bitmesini sonsuza dek beklerdi.
+ * Bunun yerine hata yazdırılır, kilit alınmaz ve tamam() false döner.
+ *
+ * @param no Yuva numarası
+ * @param yazma true ise yazma, false ise okuma kilidi
+ * @return true Kilit alındıysa
+ */
+bool yol_kilidi::al(uint8_t no, bool yazma)
+{
+    if (yazma && okunanlar[no] > 0)
+    {
+        Serial.print(F("Kilit hatasi: okunan dosyanin yuvasi ayni gorevde yazilamaz, islem yapilmadi\n"));
+        _tamam = false;
+        return false;
+    }
+    kilit_yuvasi &y = yuvalar[no];
+    TaskHandle_t ben = xTaskGetCurrentTaskHandle();
+    for (;;)
+    {
+        portENTER_CRITICAL(&depo_mux);
+        if (y.sahip == ben)
+        {
+            y.derinlik++;
+            portEXIT_CRITICAL(&depo_mux);
+            if (_yazma < 0)
+                _yazma = no;
+            else
+                _yazma2 = no;
+            return true;
+        }
+        if (y.sahip == NULL && (!yazma || y.okuyucu == 0))
+        {
+            if (yazma)
+            {
+                y.sahip = ben;
+                y.derinlik = 1;
+            }
+            else
+                y.okuyucu++;
+            portEXIT_CRITICAL(&depo_mux);
+            if (!yazma)
+            {
+                _okuma = no;
+                okunanlar[no]++;
+            }
+            else if (_yazma < 0)
+                _yazma = no;
+            else
+                _yazma2 = no;
+            return true;
+        }
+        portEXIT_CRITICAL(&depo_mux);
+        vTaskDelay(1);
+    }
+}
+
+/**
+ * @brief Tek bir dosya için okuma veya yazma kilidi alır.
+ *
+ * Kilit nesne yok edildiğinde (kapsam bitince) bırakılır.
+ *
+ * @param isim Dosya yolu
+ * @param yazma true ise yazma kilidi
+ */
+yol_kilidi::yol_kilidi(const char *isim, bool yazma)
+{
+    al(yuva_no(isim), yazma);
+}
+
+/**
+ * @brief İki dosyayı birlikte kilitler (kopyala, yeniden_adlandir).
+ *
+ * Kilitler her zaman yuva numarası sırasıyla alınır; böylece ters yönde
+ * çalışan iki kopyalama birbirini kilitleyemez. İki yol aynı yuvaya düşerse
+ * tek bir yazma kilidi alınır. İlki alınamazsa ikincisi denenmez.
+ *
+ * @param kaynak Okunan dosya
+ * @param hedef Yazılan dosya
+ * @param kaynakYazma true ise kaynak da yazma kilidiyle alınır
+ */
+yol_kilidi::yol_kilidi(const char *kaynak, const char *hedef, bool kaynakYazma)
+{
+    uint8_t k = yuva_no(kaynak);
+    uint8_t h = yuva_no(hedef);
+    if (k == h)
+        al(h, true);
+    else if (k < h)
+    {
+        if (al(k, kaynakYazma))
+            al(h, true);
+    }
+    else
+    {
+        if (al(h, true))
+            al(k, kaynakYazma);
+    }
+}
+
+yol_kilidi::~yol_kilidi()
+{
+    if (_okuma >= 0)
+        okunanlar[_okuma]--;
+    portENTER_CRITICAL(&depo_mux);
+    if (_okuma >= 0)
+        yuvalar[_okuma].okuyucu--;
+    int8_t yazmalar[2] = {_yazma, _yazma2};
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        if (yazmalar[i] >= 0 && --yuvalar[yazmalar[i]].derinlik == 0)
+            yuvalar[yazmalar[i]].sahip = NULL;
+    }
+    portEXIT_CRITICAL(&depo_mux);
+}
+
+#endif
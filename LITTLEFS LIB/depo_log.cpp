@@ -0,0 +1,247 @@
+#include "LITTLEFS_LIB.h"
+
+/**
+ * @brief Boyut sınırlı, dönen (rotating) log yöneticisi oluşturur.
+ *
+ * Satırlar `dizin` altında "/log/0000", "/log/0001" ... şeklinde numaralı
+ * segment dosyalarına eklenir. Bir segment `segmentBoyut` baytı geçecekse
+ * yeni segmente geçilir. Toplam boyut `toplamKota`yı aşarsa en eski segment
+ * silinir; böylece eski kayıtları atmak tek bir dosya silme işlemidir.
+ *
+ * @param fs Kullanılacak dosya sistemi nesnesi
+ * @param dizin Segmentlerin tutulacağı klasör
+ * @param segmentBoyut Bir segmentin en fazla boyutu (bayt)
+ * @param toplamKota Tüm segmentlerin toplam en fazla boyutu (bayt)
+ */
+log_yoneticisi::log_yoneticisi(dosya_sistemi &fs, const char *dizin, uint32_t segmentBoyut, uint32_t toplamKota)
+    : _fs(fs), _dizin(dizin), _segmentBoyut(segmentBoyut), _kota(toplamKota)
+{
+}
+
+/**
+ * @brief Segment numarasından dosya yolunu üretir.
+ *
+ * @param no Segment numarası
+ * @return String Örneğin "/log/0007"
+ */
+String log_yoneticisi::segment_yolu(uint32_t no) const
+{
+    char ad[12];
+    snprintf(ad, sizeof(ad), "%04lu", (unsigned long)no);
+    return _dizin + "/" + ad;
+}
+
+struct segment_tarama
+{
+    uint32_t ilk;
+    uint32_t son;
+    uint32_t toplam;
+    bool bulundu;
+};
+
+static bool segment_topla(const String &yol, bool dizin, uint32_t boyut, uint8_t derinlik, void *veri)
+{
+    if (dizin || derinlik != 1)
+        return true;
+
+    const char *ad = yol.c_str() + yol.lastIndexOf('/') + 1;
+    char *son;
+    unsigned long no = strtoul(ad, &son, 10);
+    if (son == ad || *son != '\0')
+        return true; // segment adı değil
+
+    segment_tarama *t = (segment_tarama *)veri;
+    if (!t->bulundu || no < t->ilk)
+        t->ilk = no;
+    if (!t->bulundu || no > t->son)
+        t->son = no;
+    t->toplam += boyut;
+    t->bulundu = true;
+    return true;
+}
+
+/**
+ * @brief Log klasörünü hazırlar ve mevcut segmentleri bulur.
+ *
+ * Klasör yoksa oluşturulur. Varsa en eski ve en yeni segment ile toplam boyut
+ * tek bir klasör taramasıyla belirlenir. kur() sonrasında bir kez çağrılır.
+ *
+ * @return true  - Log kullanıma hazır
+ * @return false - Klasör oluşturulamadı veya okunamadı
+ */
+bool log_yoneticisi::baslat()
+{
+    if (!_fs.var_mi(_dizin.c_str()) && !_fs.dizin_olustur(_dizin.c_str()))
+        return false;
+
+    segment_tarama t = {0, 0, 0, false};
+    if (!_fs.dolas(_dizin.c_str(), segment_topla, &t))
+        return false;
+
+    _bos = !t.bulundu;
+    _ilk = t.ilk;
+    _son = t.son;
+    _toplam = t.toplam;
+    _sonBoyut = 0;
+    if (!_bos)
+    {
+        int32_t b = _fs.boyut(segment_yolu(_son).c_str());
+        _sonBoyut = b < 0 ? 0 : b;
+    }
+    return true;
+}
+
+/**
+ * @brief En yeni segmente bir satır ekler.
+ *
+ * Satıra `\n` eklenir. Segment dolacaksa önce yeni segmente geçilir,
+ * ardından kota aşılıyorsa en eski segmentler silinir.
+ *
+ * @param satir Eklenecek satır (satır sonu olmadan)
+ * @return true  - Satır yazıldı
+ * @return false - Segment açılamadı
+ */
+bool log_yoneticisi::ekle(const String &satir)
+{
+    uint32_t ek = satir.length() + 1;
+    if (_bos)
+        _bos = false;
+    else if (_sonBoyut > 0 && _sonBoyut + ek > _segmentBoyut)
+    {
+        _son++;
+        _sonBoyut = 0;
+    }
+
+    String yol = segment_yolu(_son);
+    yol_kilidi kilit(yol.c_str(), true);
+    if (!kilit.tamam())
+        return false;
+    File dosya = _fs.depo().open(yol.c_str(), "a");
+    if (!dosya)
+        return false;
+    size_t yazilan = dosya.print(satir);
+    yazilan += dosya.print('\n');
+    dosya.close();
+
+    _fs.dosya_degisti(yol.c_str(), yazilan);
+    _sonBoyut += yazilan;
+    _toplam += yazilan;
+    kotayi_uygula();
+    return yazilan == ek;
+}
+
+/**
+ * @brief Mevcut segmenti kapatıp sonraki eklemeleri yeni segmente yönlendirir.
+ *
+ * @return true  - Yeni segmente geçildi
+ * @return false - Mevcut segment zaten boş
+ */
+bool log_yoneticisi::dondur()
+{
+    if (_bos || _sonBoyut == 0)
+        return false;
+    _son++;
+    _sonBoyut = 0;
+    return true;
+}
+
+/**
+ * @brief Toplam boyut kotanın altına inene kadar en eski segmentleri siler.
+ *
+ * En yeni segment hiçbir zaman silinmez.
+ */
+void log_yoneticisi::kotayi_uygula()
+{
+    while (_toplam > _kota && _ilk < _son)
+    {
+        String yol = segment_yolu(_ilk);
+        yol_kilidi kilit(yol.c_str(), true);
+        if (!kilit.tamam())
+            break;
+        int32_t b = _fs.boyut(yol.c_str());
+        if (b > 0 && _fs.depo().remove(yol.c_str()))
+        {
+            _fs.dosya_degisti(yol.c_str(), -b);
+            _toplam = (uint32_t)b > _toplam ? 0 : _toplam - b;
+        }
+        _ilk++;
+    }
+}
+
+/**
+ * @brief Tüm segmentleri siler.
+ */
+void log_yoneticisi::temizle()
+{
+    if (!_bos)
+    {
+        for (uint32_t no = _ilk; no <= _son; no++)
+        {
+            String yol = segment_yolu(no);
+            yol_kilidi kilit(yol.c_str(), true);
+            int32_t b = kilit.tamam() ? _fs.boyut(yol.c_str()) : -1;
+            if (b >= 0 && _fs.depo().remove(yol.c_str()))
+                _fs.dosya_degisti(yol.c_str(), -b);
+        }
+    }
+    _bos = true;
+    _ilk = _son = 0;
+    _sonBoyut = _toplam = 0;
+}
+
+/**
+ * @brief Tüm segmentleri eskiden yeniye tek bir satır akışı olarak okur.
+ *
+ * @param log Okunacak log yöneticisi
+ */
+log_okuyucu::log_okuyucu(log_yoneticisi &log)
+    : _log(log), _segment(log.ilk_segment()), _bitti(log.bos())
+{
+}
+
+/**
+ * @brief Sıradaki satırı okur, segment bitince bir sonrakine geçer.
+ *
+ * Okuma sırasında silinmiş segmentler atlanır.
+ *
+ * @param satir Okunan satır (satır sonu olmadan)
+ * @return true  - Satır okundu
+ * @return false - Tüm segmentler bitti
+ */
+bool log_okuyucu::sonraki(String &satir)
+{
+    while (!_bitti)
+    {
+        if (_dosya && _dosya.available())
+        {
+            satir = _dosya.readStringUntil('\n');
+            return true;
+        }
+        if (_dosya)
+        {
+            _dosya.close();
+            _segment++;
+        }
+        if (_segment > _log.son_segment())
+        {
+            _bitti = true;
+            break;
+        }
+        if (_segment < _log.ilk_segment())
+            _segment = _log.ilk_segment();
+        _dosya = _log.depo().open(_log.segment_yolu(_segment).c_str(), "r");
+        if (!_dosya)
+            _segment++;
+    }
+    return false;
+}
+
+/**
+ * @brief Açık segment dosyasını kapatır ve okumayı bitirir.
+ */
+void log_okuyucu::kapat()
+{
+    if (_dosya)
+        _dosya.close();
+    _bitti = true;
+}
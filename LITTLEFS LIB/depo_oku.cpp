@@ -1,41 +1,81 @@
 #include "LITTLEFS_LIB.h"
 
+/**
+ * @brief Açık dosyanın bulunduğu konumdan sonuna kadar olan kısmını String'e ekler.
+ *
+ * Okuma DEPO_TAMPON boyutlu bloklarla yapılır, String bir kez ayrılır.
+ */
+static void sona_kadar_oku(File &dosya, String &cikti)
+{
+    uint8_t tampon[DEPO_TAMPON];
+    cikti.reserve(cikti.length() + dosya.size() - dosya.position());
+    while (dosya.available())
+    {
+        size_t n = dosya.read(tampon, sizeof(tampon));
+        if (n == 0)
+            break;
+        cikti.concat((const char *)tampon, n);
+    }
+}
+
+
+/**
+ * @brief gunluk_oku() ile gelen parçaları String'e ekler.
+ */
+static bool stringe_ekle(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    ((String *)veri)->concat((const char *)parca, uzunluk);
+    return true;
+}
 
 /**
  * @brief Dosyadan belirtilen satırı okur.
  * 
+ * Satırın konumu satir_konumu() ile bloklar halinde bulunur, ardından yalnızca
+ * o satır okunur; önceki satırlar için String oluşturulmaz.
+ * 
  * @param isim Dosya yolu
  * @param satirNo Okunacak satır numarası (0 tabanlı)
  * @return String Okunan satır içeriği, satır yoksa boş string döner
  */
-String dosya_sistemi::satir_oku(const char* isim, uint16_t satirNo) {
-    File dosya = LittleFS.open(isim, "r");
-    if (!dosya) return String();
-    
-    uint16_t sayac = 0;
-    String satir = "";
-    while (dosya.available()) {
-        char c = dosya.read();
-        if (c == '\n') {
-            if (sayac == satirNo) {
-                dosya.close();
-                return satir;
-            }
-            satir = "";
-            sayac++;
-        } else {
-            if (sayac == satirNo) {
-                satir += c;
-            }
+String dosya_sistemi::satir_oku(const char* isim, uint32_t satirNo) {
+    yol_kilidi kilit(isim, false);
+    String gunluklu;
+    int8_t gunluk = gunluk_oku(isim, satirNo, satirNo, stringe_ekle, &gunluklu);
+    if (gunluk == 0) return String();
+    if (gunluk == 1) {
+        gunluklu.remove(gunluklu.length() - (gunluklu.endsWith("\n") ? 1 : 0));
+        return gunluklu;
+    }
+    String sabit;
+    if (sabitten_oku(isim, &sabit, nullptr)) {
+        int bas = 0;
+        for (uint32_t i = 0; i < satirNo && bas >= 0; i++) {
+            bas = sabit.indexOf('\n', bas);
+            if (bas >= 0) bas++;
         }
+        if (bas < 0 || bas >= (int)sabit.length()) return String();
+        int son = sabit.indexOf('\n', bas);
+        return sabit.substring(bas, son < 0 ? sabit.length() : son);
     }
-    // Dosyanın son satırı ise ve '\n' yoksa
-    if (sayac == satirNo) {
-        dosya.close();
-        return satir;
+    uint32_t bas, uzunluk;
+    if (!satir_konumu(isim, satirNo, bas, uzunluk)) return String();
+
+    File dosya = _depo.open(isim, "r");
+    if (!dosya) return String();
+
+    String satir = "";
+    satir.reserve(uzunluk);
+    uint8_t tampon[DEPO_TAMPON];
+    dosya.seek(bas, SeekSet);
+    while (uzunluk > 0) {
+        size_t n = dosya.read(tampon, uzunluk < sizeof(tampon) ? uzunluk : sizeof(tampon));
+        if (n == 0) break;
+        satir.concat((const char *)tampon, n);
+        uzunluk -= n;
     }
     dosya.close();
-    return String();
+    return satir;
 }
 
 
@@ -43,7 +83,7 @@ String dosya_sistemi::satir_oku(const char* isim, uint16_t satirNo) {
 /**
  * @brief Bir dosyanın tüm içeriğini okur.
  *
- * Belirtilen dosyayı açar ve içindeki tüm satırları okuyarak tek bir String'e ekler.
+ * Belirtilen dosyayı açar ve içeriğini olduğu gibi tek bir String'e okur.
  * Dosya açılamazsa boş string döner.
  *
  * @param isim Okunacak dosyanın yolu ("/veri.txt" gibi)
@@ -51,21 +91,28 @@ String dosya_sistemi::satir_oku(const char* isim, uint16_t satirNo) {
  */
 String dosya_sistemi::oku(const char *isim)
 {
+    yol_kilidi kilit(isim, false);
     String dosyaIcerigi = "";
-    File dosya = LittleFS.open(isim, "r");
-
-    if (!dosya || dosya.isDirectory())
+    int8_t gunluk = gunluk_oku(isim, 0, DEPO_DOSYA_SONU, stringe_ekle, &dosyaIcerigi);
+    if (gunluk == 1)
+        return dosyaIcerigi;
+    if (gunluk == 0)
     {
-        Serial.print(F("Dosya açılamadı"));
+        Serial.print(F("Günlük birleştirilemedi"));
         return "";
     }
+    int32_t sabitBoyut;
+    if (sabitten_oku(isim, &dosyaIcerigi, &sabitBoyut) && sabitBoyut >= 0)
+        return dosyaIcerigi;
+    File dosya = _depo.open(isim, "r");
 
-    while (dosya.available())
+    if (!dosya || dosya.isDirectory())
     {
-        String satir = dosya.readStringUntil('\n');
-        dosyaIcerigi += satir + "\n";
+        Serial.print(F("Dosya açılamadı"));
+        return "";
     }
 
+    sona_kadar_oku(dosya, dosyaIcerigi);
     dosya.close();
     return dosyaIcerigi;
 }
@@ -74,7 +121,10 @@ String dosya_sistemi::oku(const char *isim)
  * @brief Bir dosyadaki belirli satır aralığını okur.
  *
  * Örneğin 3. satırdan 6. satıra kadar olan içerik alınabilir.
- * Eğer `sonSatir` 0xFFFF ise sadece `ilkSatir` okunur.
+ * Eğer `sonSatir` DEPO_SATIR_YOK ise sadece `ilkSatir` okunur; dosyanın
+ * sonuna kadar okumak için DEPO_DOSYA_SONU verilir. İlk satırın konumu
+ * satir_konumu() ile bulunur, oradan bloklar halinde okunup `sonSatir`dan
+ * sonra durulur; satır sayısı önceden hesaplanmaz.
  * Hatalı aralık verilirse boş string döner.
  *
  * @param isim Okunacak dosyanın yolu
@@ -82,24 +132,35 @@ String dosya_sistemi::oku(const char *isim)
  * @param sonSatir Bitiş satırı (dahil)
  * @return String Belirtilen satırlar birleşik olarak döner
  */
-String dosya_sistemi::oku(const char *isim, uint16_t ilkSatir, uint16_t sonSatir)
+String dosya_sistemi::oku(const char *isim, uint32_t ilkSatir, uint32_t sonSatir)
 {
-    if (sonSatir == 0xFFFF)
+    yol_kilidi kilit(isim, false);
+    if (sonSatir == DEPO_SATIR_YOK)
         sonSatir = ilkSatir;
+    String gunluklu;
+    int8_t gunluk = gunluk_oku(isim, ilkSatir, sonSatir, stringe_ekle, &gunluklu);
+    if (gunluk < 0)
+        gunluk = sabit_oku(isim, ilkSatir, sonSatir, stringe_ekle, &gunluklu);
+    if (gunluk == 1)
+        return gunluklu;
+    if (gunluk == 0)
+    {
+        Serial.print(F("Günlük birleştirilemedi"));
+        return "";
+    }
 
-    String dosyaIcerigi = "";
-    int16_t toplamSatir = satir_hesap(isim);
-
-    if (toplamSatir < 0 || ilkSatir >= toplamSatir)
+    uint32_t bas, uzunluk;
+    if (!satir_konumu(isim, ilkSatir, bas, uzunluk))
     {
         Serial.print(F("Geçersiz satır aralığı"));
         return "";
     }
 
-    if (sonSatir >= toplamSatir)
-        sonSatir = toplamSatir - 1;
+    String dosyaIcerigi = "";
+    if (sonSatir < ilkSatir)
+        return dosyaIcerigi;
 
-    File dosya = LittleFS.open(isim, "r");
+    File dosya = _depo.open(isim, "r");
 
     if (!dosya || dosya.isDirectory())
     {
@@ -107,40 +168,590 @@ String dosya_sistemi::oku(const char *isim, uint16_t ilkSatir, uint16_t sonSatir
         return "";
     }
 
-    uint16_t mevcutSatir = 0;
-    while (dosya.available())
+    uint8_t tampon[DEPO_TAMPON];
+    uint32_t kalan = sonSatir - ilkSatir + 1; // okunacak satır sayısı
+    dosya.seek(bas, SeekSet);
+    while (kalan > 0 && dosya.available())
     {
-        String satir = dosya.readStringUntil('\n');
-        if (mevcutSatir >= ilkSatir && mevcutSatir <= sonSatir)
-            dosyaIcerigi += satir + "\n";
-
-        if (mevcutSatir++ > sonSatir)
+        size_t n = dosya.read(tampon, sizeof(tampon));
+        if (n == 0)
             break;
+        size_t son = n;
+        for (size_t i = 0; i < n; i++)
+        {
+            if (tampon[i] == '\n' && --kalan == 0)
+            {
+                son = i + 1;
+                break;
+            }
+        }
+        dosyaIcerigi.concat((const char *)tampon, son);
     }
-
     dosya.close();
+
+    if (kalan > 0 && dosyaIcerigi.length() > 0 && !dosyaIcerigi.endsWith("\n"))
+        dosyaIcerigi += "\n"; // sonunda satır sonu olmayan son satır
     return dosyaIcerigi;
 }
 
+/**
+ * @brief Bir dosyadaki satır aralığını okur.
+ *
+ * @param isim Okunacak dosyanın yolu
+ * @param aralik Okunacak satırlar (örn. satir_araligi::sona_kadar(100))
+ * @return String Belirtilen satırlar birleşik olarak döner
+ */
+String dosya_sistemi::oku(const char *isim, const satir_araligi &aralik)
+{
+    return oku(isim, aralik.ilk, aralik.son);
+}
+
 /**
  * @brief Satır okuyucu yardımcı fonksiyon.
  *
  * Tek bir satırı okur ve içeriği parametreye yazar.
+ * Boş satırlar da geçerli satırdır; false yalnızca dosya sonunda döner.
  *
  * @param dosya Açık dosya referansı
- * @param satir Okunan satır verisini içerir
- * @return true Satır varsa, false boşsa
+ * @param satir Okunan satır verisini içerir (satır sonu olmadan)
+ * @return true Satır okunduysa, false dosya sonuna gelindiyse
  */
 bool dosya_sistemi::satirOku(File &dosya, String &satir)
 {
+    if (!dosya.available())
+    {
+        satir = "";
+        return false;
+    }
     satir = dosya.readStringUntil('\n');
-    return (satir.length() > 0);
+    return true;
+}
+
+/**
+ * @brief Dosyanın satırlarını kopyasız dolaşmak için bir aralık döndürür.
+ *
+ * Satırlar için String oluşturulmaz; her adımda DEPO_SATIR_TAMPON boyutlu
+ * iç tampondaki satırı gösteren bir satir_gorunumu verilir:
+ *
+ *     for (const satir_gorunumu &s : fs.satirlar("/x.csv"))
+ *         Serial.write(s.veri, s.uzunluk);
+ *
+ * Tampondan uzun satırlar birden fazla parça halinde gelir (bkz. bas/son).
+ * Satır modeli satir_hesap() ile aynıdır. Dolaşma boyunca kilit tutulmaz.
+ * Dosya günlüklüyse satırlar günlük tabanla birleştirilerek verilir; günlük
+ * tabana işlenmez. Kayıtların bir kopyası akışta tutulur, dolaşma sırasında
+ * yapılan düzenlemeler akışa yansımaz. RAM'e sabitlenmiş dosyada da içeriğin
+ * bir kopyası alınır; kirli dosya flash'a aktarılmaz.
+ *
+ * @param isim Dosya yolu
+ * @param ilkSatir İlk verilecek satır (0 tabanlı)
+ * @param sonSatir Son verilecek satır (dahil), DEPO_DOSYA_SONU: dosyanın sonuna kadar
+ * @return satir_akisi range-for ile kullanılabilen aralık; dosya açılamazsa boş
+ */
+satir_akisi dosya_sistemi::satirlar(const char *isim, uint32_t ilkSatir, uint32_t sonSatir)
+{
+    yol_kilidi kilit(isim, false);
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0)
+        return satir_akisi(_depo.open(isim, "r"), ilkSatir, sonSatir, g->kayitlar, g->kayitSayisi, g->satir);
+    const String *sabit = sabit_icerik(isim);
+    if (sabit)
+        return satir_akisi(*sabit, ilkSatir, sonSatir);
+    return satir_akisi(_depo.open(isim, "r"), ilkSatir, sonSatir);
+}
+
+satir_akisi::satir_akisi(File dosya, uint32_t ilk, uint32_t son)
+    : _dosya(dosya), _ilk(ilk), _son(son), _acik(dosya && !dosya.isDirectory())
+{
+}
+
+/**
+ * @brief Sabit dosyanın RAM kopyası için bir satır akışı kurar.
+ *
+ * İçerik kopyalanır; akış kilit tutulmadan dolaşılırken yapılan yazmalar
+ * akışı bozmaz. Satırlar dosyadaki gibi tampon üzerinden verilir.
+ */
+satir_akisi::satir_akisi(const String &icerik, uint32_t ilk, uint32_t son)
+    : _ilk(ilk), _son(son), _kayitlar(icerik), _bellekte(true)
+{
+    _acik = _kayitlar.length() == icerik.length(); // kopya için bellek yetmediyse
+}
+
+/**
+ * @brief Akışı taşır; dosya ve kayıt tablosu yeni akışa geçer, kaynak kapanır.
+ *
+ * Böylece dosya yalnızca bir kez kapatılır ve tablo bir kez serbest bırakılır.
+ * Yineleyiciler akışın adresini tuttuğu için akış dolaşılmadan önce taşınmalıdır.
+ */
+satir_akisi::satir_akisi(satir_akisi &&diger)
+    : _dosya(diger._dosya), _dolu(diger._dolu), _konum(diger._konum), _satir(diger._satir), _ilk(diger._ilk),
+      _son(diger._son), _satirBasi(diger._satirBasi), _acik(diger._acik), _kayit(diger._kayit),
+      _kayitlar(std::move(diger._kayitlar)), _bellekte(diger._bellekte), _bellekKonum(diger._bellekKonum),
+      _kayitAdet(diger._kayitAdet), _cikis(diger._cikis),
+      _cikisBitis(diger._cikisBitis), _tabanda(diger._tabanda), _eksik(diger._eksik)
+{
+    memcpy(_tampon, diger._tampon, _dolu);
+    diger._dosya = File();
+    diger._kayit = nullptr;
+    diger._kayitAdet = 0;
+    diger._acik = false;
+}
+
+satir_akisi::~satir_akisi()
+{
+    if (_dosya)
+        _dosya.close();
+    free(_kayit);
+}
+
+bool satir_akisi::ilerle()
+{
+    return _kayit ? gunlukten_ilerle() : dosyadan_ilerle();
+}
+
+/**
+ * @brief Tampona dosyadan ya da RAM kopyasından en fazla `uzunluk` bayt okur.
+ */
+size_t satir_akisi::parca_oku(char *hedef, size_t uzunluk)
+{
+    if (!_bellekte)
+        return _dosya.read((uint8_t *)hedef, uzunluk);
+    size_t kalan = _kayitlar.length() - _bellekKonum;
+    if (uzunluk > kalan)
+        uzunluk = kalan;
+    memcpy(hedef, _kayitlar.c_str() + _bellekKonum, uzunluk);
+    _bellekKonum += uzunluk;
+    return uzunluk;
+}
+
+/**
+ * @brief Bir sonraki satırı (veya uzun satırın bir sonraki parçasını) hazırlar.
+ *
+ * Tamponda satır sonu yoksa kalan kısım tamponun başına kaydırılıp tampon
+ * doldurulur; satır yine sığmıyorsa tamponun tamamı bir parça olarak verilir.
+ *
+ * @return true Yeni bir görünüm hazırlandıysa, false dosya veya aralık bittiyse
+ */
+bool satir_akisi::dosyadan_ilerle()
+{
+    if (!_acik)
+        return false;
+    while (_satir <= _son)
+    {
+        if (_konum >= _dolu)
+        {
+            _konum = 0;
+            _dolu = parca_oku(_tampon, sizeof(_tampon));
+            if (_dolu == 0)
+                break;
+        }
+
+        const char *bulunan = (const char *)memchr(_tampon + _konum, '\n', _dolu - _konum);
+        if (!bulunan && _konum > 0)
+        {
+            memmove(_tampon, _tampon + _konum, _dolu - _konum);
+            _dolu -= _konum;
+            _konum = 0;
+            _dolu += parca_oku(_tampon + _dolu, sizeof(_tampon) - _dolu);
+            bulunan = (const char *)memchr(_tampon, '\n', _dolu);
+        }
+
+        _gorunum.veri = _tampon + _konum;
+        _gorunum.no = _satir;
+        _gorunum.bas = _satirBasi;
+        if (bulunan)
+        {
+            _gorunum.uzunluk = bulunan - _gorunum.veri;
+            _gorunum.son = true;
+            _konum += _gorunum.uzunluk + 1;
+        }
+        else
+        {
+            _gorunum.uzunluk = _dolu - _konum;
+            // sonunda satır sonu olmayan son satır
+            _gorunum.son = _bellekte ? _bellekKonum >= _kayitlar.length() : !_dosya.available();
+            _konum = _dolu;
+        }
+
+        _satirBasi = _gorunum.son;
+        if (_gorunum.son)
+            _satir++;
+        if (_gorunum.no >= _ilk)
+            return true;
+    }
+    _dosya.close();
+    _acik = false;
+    return false;
+}
+
+/**
+ * @brief Dosyanın son satırlarını okur (tail).
+ *
+ * Dosyanın sonuna konumlanılır ve DEPO_TAMPON boyutlu bloklar halinde geriye
+ * doğru `\n` aranır. Bu yüzden maliyet dosya boyutuna değil, okunan satırların
+ * boyutuna bağlıdır. Dosyanın en sonundaki `\n` yeni bir satır sayılmaz.
+ * Günlüklü dosyada son satırlar günlük tabanla birleştirilerek verilir.
+ *
+ * @param isim Okunacak dosyanın yolu
+ * @param adet İstenen satır sayısı
+ * @return String Son `adet` satır (satır sonları dahil), dosya açılamazsa boş string
+ */
+String dosya_sistemi::son_satirlar(const char *isim, uint32_t adet)
+{
+    yol_kilidi kilit(isim, false);
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0)
+    {
+        String gunluklu = "";
+        if (adet > 0 && g->satir > 0 &&
+            gunluk_oku(isim, g->satir > adet ? g->satir - adet : 0, DEPO_DOSYA_SONU, stringe_ekle, &gunluklu) == 0)
+        {
+            Serial.print(F("Günlük birleştirilemedi"));
+            return "";
+        }
+        return gunluklu;
+    }
+    const String *sabit = sabit_icerik(isim);
+    if (sabit)
+    {
+        // Flash'taki gibi geriye doğru aranır; son bayt satır sonu olsa da sayılmaz
+        uint32_t sayac = 0;
+        for (uint32_t i = sabit->length() > 0 ? sabit->length() - 1 : 0; i > 0 && adet > 0; i--)
+        {
+            if ((*sabit)[i - 1] == '\n' && ++sayac == adet)
+                return sabit->substring(i);
+        }
+        return adet > 0 ? *sabit : String();
+    }
+    File dosya = _depo.open(isim, "r");
+    if (!dosya || dosya.isDirectory())
+    {
+        Serial.print(F("Dosya açılamadı"));
+        return "";
+    }
+
+    uint32_t boyut = dosya.size();
+    if (adet == 0 || boyut == 0)
+    {
+        dosya.close();
+        return "";
+    }
+
+    uint8_t tampon[DEPO_TAMPON];
+    uint32_t baslangic = 0;
+    uint32_t sayac = 0;
+    uint32_t son = boyut - 1; // son bayt satır sonu olsa da sayılmaz
+    bool bulundu = false;
+
+    while (son > 0 && !bulundu)
+    {
+        uint32_t bas = son > DEPO_TAMPON ? son - DEPO_TAMPON : 0;
+        dosya.seek(bas, SeekSet);
+        size_t n = dosya.read(tampon, son - bas);
+        for (size_t i = n; i > 0; i--)
+        {
+            if (tampon[i - 1] == '\n' && ++sayac == adet)
+            {
+                baslangic = bas + i;
+                bulundu = true;
+                break;
+            }
+        }
+        son = bas;
+    }
+
+    String cikti = "";
+    dosya.seek(baslangic, SeekSet);
+    sona_kadar_oku(dosya, cikti);
+    dosya.close();
+    return cikti;
+}
+
+/**
+ * @brief Dosyanın belirtilen bayt konumundan sonrasını okur (takip modu).
+ *
+ * Log takibi için kullanılır: dönen `yeniKonum` bir sonraki çağrıda tekrar
+ * verilerek yalnızca yeni eklenen kısım okunur. Dosya küçülmüşse (silinip
+ * yeniden oluşturulmuşsa) okumaya baştan başlanır. Günlüklü dosyada
+ * konumlar günlük uygulanmış içeriğe göredir.
+ *
+ * @param isim Okunacak dosyanın yolu
+ * @param konum Okumaya başlanacak bayt konumu
+ * @param yeniKonum Okuma sonrası dosya sonu konumu (isteğe bağlı)
+ * @return String `konum`dan dosya sonuna kadar olan içerik
+ */
+String dosya_sistemi::oku_konumdan(const char *isim, uint32_t konum, uint32_t *yeniKonum)
+{
+    yol_kilidi kilit(isim, false);
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0)
+    {
+        int32_t toplam = gunluk_boyut(*g);
+        String cikti = "";
+        if (toplam >= 0 && konum > (uint32_t)toplam)
+            konum = 0;
+        if (toplam < 0 || aktar(isim, stringe_ekle, &cikti, konum) < 0)
+        {
+            cikti = "";
+            toplam = konum;
+        }
+        if (yeniKonum)
+            *yeniKonum = toplam;
+        return cikti;
+    }
+    const String *sabit = sabit_icerik(isim);
+    if (sabit)
+    {
+        if (konum > sabit->length())
+            konum = 0;
+        if (yeniKonum)
+            *yeniKonum = sabit->length();
+        return sabit->substring(konum);
+    }
+    File dosya = _depo.open(isim, "r");
+    if (!dosya || dosya.isDirectory())
+    {
+        if (yeniKonum)
+            *yeniKonum = konum;
+        return "";
+    }
+
+    uint32_t boyut = dosya.size();
+    if (konum > boyut)
+        konum = 0;
+
+    String cikti = "";
+    dosya.seek(konum, SeekSet);
+    sona_kadar_oku(dosya, cikti);
+    if (yeniKonum)
+        *yeniKonum = boyut;
+    dosya.close();
+    return cikti;
+}
+
+/**
+ * @brief aktar()'ın Print hedefleri için kullandığı geri çağırma.
+ */
+static bool print_e_yaz(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    return ((Print *)veri)->write(parca, uzunluk) == uzunluk;
+}
+
+struct bayt_araligi
+{
+    uint32_t atla;  // henüz atlanacak bayt
+    uint32_t kalan; // en fazla aktarılacak bayt
+    aktar_fn fn;
+    void *veri;
+    uint32_t aktarilan;
+};
+
+/**
+ * @brief Birleştirilmiş günlük içeriğinden bir bayt aralığını kesip `fn`e verir.
+ */
+static bool araliga_aktar(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    bayt_araligi *a = (bayt_araligi *)veri;
+    if (a->atla >= uzunluk)
+    {
+        a->atla -= uzunluk;
+        return true;
+    }
+    parca += a->atla;
+    uzunluk -= a->atla;
+    a->atla = 0;
+    if (a->kalan == 0)
+        return false;
+    if (uzunluk > a->kalan)
+        uzunluk = a->kalan;
+    if (!a->fn(parca, uzunluk, a->veri))
+        return false;
+    a->aktarilan += uzunluk;
+    a->kalan -= uzunluk;
+    return a->kalan > 0;
+}
+
+/**
+ * @brief Dosyanın bir bayt aralığını String oluşturmadan geri çağırmaya verir.
+ *
+ * İçerik DEPO_AKTAR_TAMPON boyutlu yığın tamponuyla parça parça okunur;
+ * kullanılan bellek dosya boyutundan bağımsızdır. Dosya RAM'e sabitlenmişse
+ * parçalar doğrudan RAM kopyasından, günlüklüyse günlük tabanla birleştirilerek
+ * verilir. `fn` false dönerse aktarma durur. Dosyanın okuma kilidi aktarma
+ * boyunca tutulur; `fn` içinden aynı dosyaya yazılmamalıdır.
+ *
+ * @param isim Dosya yolu
+ * @param fn Her parça için çağrılır
+ * @param veri `fn`e aynen geçirilen kullanıcı verisi
+ * @param konum Aktarmaya başlanacak bayt konumu
+ * @param uzunluk En fazla aktarılacak bayt; DEPO_DOSYA_SONU: dosyanın sonuna kadar
+ * @return int32_t Aktarılan bayt (`konum` dosyanın sonundaysa 0), dosya açılamazsa
+ *         veya günlük birleştirilemezse -1
+ */
+int32_t dosya_sistemi::aktar(const char *isim, aktar_fn fn, void *veri, uint32_t konum, uint32_t uzunluk)
+{
+    yol_kilidi kilit(isim, false);
+    bayt_araligi aralik = {konum, uzunluk, fn, veri, 0};
+    int8_t gunluk = gunluk_oku(isim, 0, DEPO_DOSYA_SONU, araliga_aktar, &aralik);
+    if (gunluk >= 0)
+        return gunluk == 1 ? (int32_t)aralik.aktarilan : -1;
+    sabit_kaydi *s = sabit_bul(isim);
+    if (s && s->yuklu)
+    {
+        if (!s->var)
+            return -1;
+        yol_kilidi::kritik_gir();
+        _sabitIstatistik.ram_okuma++;
+        yol_kilidi::kritik_cik();
+        uint32_t boyut = s->icerik.length();
+        if (konum >= boyut)
+            return 0;
+        uint32_t n = boyut - konum < uzunluk ? boyut - konum : uzunluk;
+        return fn((const uint8_t *)s->icerik.c_str() + konum, n, veri) ? n : 0;
+    }
+
+    File dosya = _depo.open(isim, "r");
+    if (!dosya || dosya.isDirectory())
+        return -1;
+
+    uint8_t tampon[DEPO_AKTAR_TAMPON];
+    int32_t aktarilan = 0;
+    if (konum < dosya.size() && dosya.seek(konum, SeekSet))
+    {
+        while (uzunluk > 0)
+        {
+            size_t n = dosya.read(tampon, uzunluk < sizeof(tampon) ? uzunluk : sizeof(tampon));
+            if (n == 0 || !fn(tampon, n, veri))
+                break;
+            aktarilan += n;
+            uzunluk -= n;
+        }
+    }
+    dosya.close();
+    return aktarilan;
+}
+
+/**
+ * @brief Dosyanın satır aralığını String oluşturmadan geri çağırmaya verir.
+ *
+ * Aktarılan içerik oku(isim, aralik) ile aynıdır: satır sonu olmayan son
+ * satırın sonuna '\n' eklenir. İlk satırın konumu satir_konumu() ile bulunur,
+ * sonrası bayt aralığında olduğu gibi parça parça okunur.
+ *
+ * @param isim Dosya yolu
+ * @param fn Her parça için çağrılır; false dönerse aktarma durur
+ * @param veri `fn`e aynen geçirilen kullanıcı verisi
+ * @param aralik Aktarılacak satırlar
+ * @return int32_t Aktarılan bayt, dosya açılamaz veya ilk satır yoksa -1
+ */
+int32_t dosya_sistemi::aktar(const char *isim, aktar_fn fn, void *veri, const satir_araligi &aralik)
+{
+    yol_kilidi kilit(isim, false);
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0)
+    {
+        if (aralik.ilk >= g->satir)
+            return -1;
+        if (aralik.son < aralik.ilk)
+            return 0;
+        bayt_araligi sayac = {0, DEPO_DOSYA_SONU, fn, veri, 0};
+        return gunluk_oku(isim, aralik.ilk, aralik.son, araliga_aktar, &sayac) == 1 ? (int32_t)sayac.aktarilan : -1;
+    }
+    int32_t sabitSatir = sabit_satir_sayisi(isim);
+    if (sabitSatir >= 0)
+    {
+        if (aralik.ilk >= (uint32_t)sabitSatir)
+            return -1;
+        if (aralik.son < aralik.ilk)
+            return 0;
+        bayt_araligi sayac = {0, DEPO_DOSYA_SONU, fn, veri, 0};
+        sabit_oku(isim, aralik.ilk, aralik.son, araliga_aktar, &sayac);
+        return sayac.aktarilan;
+    }
+    uint32_t bas, uzunluk;
+    if (!satir_konumu(isim, aralik.ilk, bas, uzunluk))
+        return -1;
+    if (aralik.son < aralik.ilk)
+        return 0;
+
+    File dosya = _depo.open(isim, "r");
+    if (!dosya || dosya.isDirectory())
+        return -1;
+
+    uint8_t tampon[DEPO_AKTAR_TAMPON];
+    uint32_t kalan = aralik.son - aralik.ilk + 1; // aktarılacak satır sayısı
+    int32_t aktarilan = 0;
+    bool durdu = false;
+    uint8_t sonKarakter = '\n';
+    dosya.seek(bas, SeekSet);
+    while (kalan > 0)
+    {
+        size_t n = dosya.read(tampon, sizeof(tampon));
+        if (n == 0)
+            break;
+        for (size_t i = 0; i < n; i++)
+        {
+            if (tampon[i] == '\n' && --kalan == 0)
+            {
+                n = i + 1;
+                break;
+            }
+        }
+        if (!fn(tampon, n, veri))
+        {
+            durdu = true;
+            break;
+        }
+        aktarilan += n;
+        sonKarakter = tampon[n - 1];
+    }
+    dosya.close();
+
+    if (!durdu && kalan > 0 && sonKarakter != '\n')
+    {
+        const uint8_t satirSonu = '\n'; // sonunda satır sonu olmayan son satır
+        if (fn(&satirSonu, 1, veri))
+            aktarilan++;
+    }
+    return aktarilan;
+}
+
+/**
+ * @brief Dosyanın bir bayt aralığını bir Print/Stream hedefine yazar.
+ *
+ * Web sunucusu istemcisi, Serial veya başka bir dosya gibi her Print
+ * hedefine, dosyanın tamamı RAM'e alınmadan aktarılır. Hedef parçanın
+ * tamamını yazamazsa (bağlantı koptuysa) aktarma durur.
+ *
+ * @param isim Dosya yolu
+ * @param hedef Yazılacak hedef
+ * @param konum Aktarmaya başlanacak bayt konumu
+ * @param uzunluk En fazla aktarılacak bayt; DEPO_DOSYA_SONU: dosyanın sonuna kadar
+ * @return int32_t Hedefe yazılan bayt, dosya açılamazsa -1
+ */
+int32_t dosya_sistemi::aktar(const char *isim, Print &hedef, uint32_t konum, uint32_t uzunluk)
+{
+    return aktar(isim, print_e_yaz, &hedef, konum, uzunluk);
+}
+
+/**
+ * @brief Dosyanın satır aralığını bir Print/Stream hedefine yazar.
+ *
+ * @param isim Dosya yolu
+ * @param hedef Yazılacak hedef
+ * @param aralik Aktarılacak satırlar
+ * @return int32_t Hedefe yazılan bayt, dosya açılamaz veya ilk satır yoksa -1
+ */
+int32_t dosya_sistemi::aktar(const char *isim, Print &hedef, const satir_araligi &aralik)
+{
+    return aktar(isim, print_e_yaz, &hedef, aralik);
 }
 
 /**
  * @brief Dosyayı .bak uzantısıyla yedekler.
  *
  * Örneğin "/veri.txt" dosyası "/veri.txt.bak" olarak yedeklenir.
+ * Yedek zaten aynı içeriğe sahipse yeniden yazılmaz.
  *
  * @param dosyaAdi Yedeklenecek dosyanın yolu
  * @return true Yedekleme başarılıysa
@@ -148,8 +759,25 @@ bool dosya_sistemi::satirOku(File &dosya, String &satir)
 bool dosya_sistemi::yedekle(const char *dosyaAdi)
 {
     String yedekAdi = String(dosyaAdi) + ".bak";
-    if (!LittleFS.exists(dosyaAdi)) return false;
-    if (LittleFS.exists(yedekAdi.c_str())) LittleFS.remove(yedekAdi.c_str());
+    yol_kilidi kilit(dosyaAdi, yedekAdi.c_str());
+    if (!kilit.tamam())
+        return false;
+    int32_t bayt = boyut(dosyaAdi);
+    if (bayt < 0) return false;
+    gunluk_kaydi *g = gunluk_bul(dosyaAdi);
+    sabit_kaydi *s = sabit_bul(dosyaAdi);
+    // Günlüklü veya kirli sabit dosyanın flash'taki hali içeriğinin kendisi değildir
+    bool ayni = !(g && g->kayitSayisi > 0) && !(s && s->kirli) && dosyalar_ayni(dosyaAdi, yedekAdi.c_str());
+    yol_kilidi::kritik_gir();
+    if (ayni)
+    {
+        _ozetIstatistik.atlanan++;
+        _ozetIstatistik.kazanilan_bayt += bayt;
+    }
+    else
+        _ozetIstatistik.yazilan++;
+    yol_kilidi::kritik_cik();
+    if (ayni) return true;
     return kopyala(dosyaAdi, yedekAdi.c_str());
 }
 
@@ -164,8 +792,7 @@ bool dosya_sistemi::yedekle(const char *dosyaAdi)
 bool dosya_sistemi::geri_yukle(const char *dosyaAdi)
 {
     String yedekAdi = String(dosyaAdi) + ".bak";
-    if (!LittleFS.exists(yedekAdi.c_str())) return false;
-    if (LittleFS.exists(dosyaAdi)) LittleFS.remove(dosyaAdi);
+    if (!_depo.exists(yedekAdi.c_str())) return false;
     return kopyala(yedekAdi.c_str(), dosyaAdi);
 }
 
@@ -173,33 +800,254 @@ bool dosya_sistemi::geri_yukle(const char *dosyaAdi)
  * @brief Dosyada belirtilen satırı arar.
  *
  * Belirtilen dosya içinde “aranan” stringi arar.
- * Eşleşme bulunduğunda satır numarası döner.
+ * Eşleşme bulunduğunda satır numarası döner. Dosya için bloom_ac() ile
+ * süzgeç açıldıysa, süzgecin "yok" dediği satırlar için dosya taranmaz.
  *
  * @param isim Dosya yolu
  * @param aranan Aranacak içerik
- * @return int16_t Bulunursa satır numarası, bulunamazsa -1
+ * @return int32_t Bulunursa satır numarası, bulunamazsa -1
  */
-int16_t dosya_sistemi::ara(const char *isim, const String &aranan)
+int32_t dosya_sistemi::ara(const char *isim, const String &aranan)
 {
-    File dosya = LittleFS.open(isim, "r");
-    if (!dosya || dosya.isDirectory())
+    // Eski süzgeç yeniden kurulacaksa yan dosya da yazılır: yazma kilidi gerekir
+    bloom_kaydi *b = bloom_bul(isim);
+    bool kurabilir = b && b->eski && !yol_kilidi::okuyor(isim); // okuma altında yazma kilidi alınamaz
+    yol_kilidi kilit(isim, kurabilir);
+    b = bloom_bul(isim);
+    int8_t suzgec = b ? bloom_sorgu(*b, aranan, kurabilir) : -1;
+    if (suzgec == 0)
+        return -1;
+
+    satir_akisi akis = satirlar(isim);
+    if (!akis.acik())
     {
         Serial.print(F("Dosya açılamadı\n"));
         return -1;
     }
 
-    uint16_t mevcutSatir = 0;
-    while (dosya.available())
+    // Satırlar kopyalanmadan parça parça karşılaştırılır
+    size_t uzunluk = aranan.length();
+    size_t eslesen = 0;
+    bool tutuyor = true;
+    for (const satir_gorunumu &s : akis)
     {
-        String satir = dosya.readStringUntil('\n');
-        if (satir == aranan)
+        if (s.bas)
         {
-            dosya.close();
-            return mevcutSatir;
+            eslesen = 0;
+            tutuyor = true;
         }
-        mevcutSatir++;
+        tutuyor = tutuyor && eslesen + s.uzunluk <= uzunluk &&
+                  memcmp(aranan.c_str() + eslesen, s.veri, s.uzunluk) == 0;
+        eslesen += s.uzunluk;
+        if (s.son && tutuyor && eslesen == uzunluk)
+            return s.no;
+    }
+    if (suzgec == 1)
+    {
+        yol_kilidi::kritik_gir();
+        _bloomIstatistik.yanlis_pozitif++;
+        yol_kilidi::kritik_cik();
     }
-
-    dosya.close();
     return -1;
 }
+
+struct bellek_yazimi
+{
+    uint8_t *hedef;
+    size_t dolu;
+};
+
+/**
+ * @brief aktar() parçalarını ardışık olarak belleğe kopyalar.
+ */
+static bool bellege_yaz(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    bellek_yazimi *b = (bellek_yazimi *)veri;
+    memcpy(b->hedef + b->dolu, parca, uzunluk);
+    b->dolu += uzunluk;
+    return true;
+}
+
+/**
+ * @brief Dosyadan ham bayt dizisi (oku_yapi) okur.
+ *
+ * `surum` 0 değilse dosya başındaki depo_yapi_basligi doğrulanır: imza,
+ * sürüm ve boyut eşleşmeli, CRC tutmalıdır. Veri aktar() ile doğrudan hedefe
+ * okunur; false dönerse hedefin içeriği geçersiz kabul edilmelidir.
+ *
+ * @param isim Dosya yolu
+ * @param veri Okunan verinin yazılacağı yer
+ * @param uzunluk Beklenen veri uzunluğu (bayt)
+ * @param surum Beklenen şema sürümü, 0 ise başlık beklenmez
+ * @return true Veri eksiksiz okunduysa (ve başlık doğruysa)
+ */
+bool dosya_sistemi::yapi_oku(const char *isim, void *veri, size_t uzunluk, uint16_t surum)
+{
+    yol_kilidi kilit(isim, false);
+    depo_yapi_basligi baslik;
+    uint32_t konum = 0;
+    if (surum != 0)
+    {
+        bellek_yazimi b = {(uint8_t *)&baslik, 0};
+        if (aktar(isim, bellege_yaz, &b, 0, sizeof(baslik)) != (int32_t)sizeof(baslik) ||
+            baslik.imza != DEPO_YAPI_IMZA || baslik.surum != surum || baslik.boyut != uzunluk)
+            return false;
+        konum = sizeof(baslik);
+    }
+
+    bellek_yazimi b = {(uint8_t *)veri, 0};
+    if (aktar(isim, bellege_yaz, &b, konum, uzunluk) != (int32_t)uzunluk)
+        return false;
+    return surum == 0 || crc32(veri, uzunluk) == baslik.crc;
+}
+
+/**
+ * @brief Sabit boyutlu kayıtlardan oluşan dosyadan tek bir kaydı okur (oku_eleman).
+ *
+ * @param isim Dosya yolu
+ * @param konum Kaydın bayt konumu
+ * @param veri Okunan kaydın yazılacağı yer
+ * @param uzunluk Kayıt uzunluğu (bayt)
+ * @return true Kayıt eksiksiz okunduysa
+ */
+bool dosya_sistemi::eleman_oku(const char *isim, uint32_t konum, void *veri, size_t uzunluk)
+{
+    bellek_yazimi b = {(uint8_t *)veri, 0};
+    return aktar(isim, bellege_yaz, &b, konum, uzunluk) == (int32_t)uzunluk;
+}
+
+struct agac_arama
+{
+    dosya_sistemi *fs;
+    const char *aranan;
+    uint8_t uzunluk;
+    uint8_t atlama[DEPO_ARA_MAX]; // KMP önek tablosu
+    ara_modu mod;
+    const char *uzanti;
+    bulundu_fn fn;
+    void *veri;
+    uint32_t bulunan;
+    bool dur;
+    // Taranan dosyanın durumu; parçalar arasında korunur
+    const String *yol;
+    uint32_t satir;
+    uint32_t konum;
+    uint32_t satirBasi;
+    int16_t j; // eşleşen karakter sayısı, -1: bu satırda artık eşleşme yok
+};
+
+/**
+ * @brief Dosyanın aktar() ile gelen bir parçasını tarar.
+ *
+ * Her satırda yalnızca ilk eşleşme bildirilir. Satır için String ayrılmaz.
+ */
+static bool dosyada_ara(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    agac_arama &a = *(agac_arama *)veri;
+    for (size_t i = 0; i < uzunluk && !a.dur; i++, a.konum++)
+    {
+        char c = parca[i];
+        if (c == '\n')
+        {
+            a.satir++;
+            a.satirBasi = a.konum + 1;
+            a.j = 0;
+            continue;
+        }
+        if (a.j < 0)
+            continue;
+
+        if (a.mod == ARA_BASLAR)
+            a.j = (c == a.aranan[a.j]) ? a.j + 1 : -1;
+        else
+        {
+            while (a.j > 0 && c != a.aranan[a.j])
+                a.j = a.atlama[a.j - 1];
+            if (c == a.aranan[a.j])
+                a.j++;
+        }
+
+        if (a.j == a.uzunluk)
+        {
+            a.bulunan++;
+            uint32_t bas = a.konum + 1 - a.uzunluk;
+            if (!a.fn(*a.yol, a.satir, bas - a.satirBasi, a.veri))
+                a.dur = true;
+            a.j = -1;
+        }
+    }
+    return !a.dur;
+}
+
+static bool agacta_ara_girdi(const String &yol, bool dizin, uint32_t boyut, uint8_t derinlik, void *veri)
+{
+    agac_arama *a = (agac_arama *)veri;
+    (void)derinlik;
+    // Günlüklü dosyanın tabanı boş olsa da günlükte satırları olabilir
+    if (dizin || (boyut == 0 && a->fs->boyut(yol.c_str()) <= 0))
+        return true;
+    if (a->uzanti && !yol.endsWith(a->uzanti))
+        return true;
+    if (yol.endsWith(".jrn") || yol.endsWith(".blm"))
+        return true; // günlük ve süzgeç yan dosyaları; içerikleri asıl dosyada taranır
+
+    a->yol = &yol;
+    a->satir = 0;
+    a->konum = 0;
+    a->satirBasi = 0;
+    a->j = 0;
+    a->fs->aktar(yol.c_str(), dosyada_ara, a);
+    return !a->dur;
+}
+
+/**
+ * @brief Bir klasör ağacındaki tüm dosyalarda metin arar (grep).
+ *
+ * Ağaç dolas() ile tek geçişte gezilir. Her dosya aktar() ile parça parça akış
+ * halinde taranır; satır başına String oluşturulmaz. Günlüklü dosyalar günlük
+ * tabanla birleştirilerek taranır, günlük tabana işlenmez; .jrn ve .blm yan
+ * dosyaları taranmaz. Eşleşen her
+ * satır için `fn` (yol, satır no, satır içi konum, veri) bir kez çağrılır.
+ * `fn` false döndürürse arama hemen biter.
+ *
+ * @param kok Aramanın başlayacağı klasör
+ * @param aranan Aranacak metin (en fazla DEPO_ARA_MAX karakter, `\n` içermemeli)
+ * @param fn Eşleşmede çağrılacak fonksiyon
+ * @param veri fn'e aynen iletilen kullanıcı verisi
+ * @param mod ARA_ICERIR: satırın herhangi bir yerinde, ARA_BASLAR: satır başında
+ * @param uzanti Yalnızca bu uzantıyla biten dosyalar taranır (örn: ".log"), nullptr ise hepsi
+ * @return uint32_t Bulunan eşleşme sayısı
+ */
+uint32_t dosya_sistemi::agacta_ara(const char *kok, const char *aranan, bulundu_fn fn, void *veri, ara_modu mod,
+                                   const char *uzanti)
+{
+    size_t uzunluk = strlen(aranan);
+    if (uzunluk == 0 || uzunluk > DEPO_ARA_MAX)
+        return 0;
+
+    diske_aktar(); // sabit dosyalar dolaşmada güncel boyutlarıyla görünsün
+    agac_arama a;
+    a.fs = this;
+    a.aranan = aranan;
+    a.uzunluk = uzunluk;
+    a.mod = mod;
+    a.uzanti = uzanti;
+    a.fn = fn;
+    a.veri = veri;
+    a.bulunan = 0;
+    a.dur = false;
+
+    // KMP önek tablosu: aranan[0..i] için hem önek hem sonek olan en uzun kısım
+    a.atlama[0] = 0;
+    for (uint8_t i = 1, k = 0; i < uzunluk; i++)
+    {
+        while (k > 0 && aranan[i] != aranan[k])
+            k = a.atlama[k - 1];
+        if (aranan[i] == aranan[k])
+            k++;
+        a.atlama[i] = k;
+    }
+
+    dolas(kok, agacta_ara_girdi, &a);
+    return a.bulunan;
+}
@@ -0,0 +1,405 @@
+#include "LITTLEFS_LIB.h"
+
+/**
+ * @brief Bir dosyayı RAM'e sabitler (write-back önbellek).
+ *
+ * Sabit dosyaya yapılan yaz/degistir/ekle/temizle çağrıları yalnızca RAM'deki
+ * kopyayı değiştirir ve dosyayı "kirli" işaretler; oku, satir_oku, boyut ve
+ * var_mi RAM'den karşılanır. Kirli dosya flash'a yalnızca şu durumlarda yazılır:
+ *  - dongu() içinde ilk aktarılmamış yazmanın üzerinden sabit_ayarla() süresi geçtiyse,
+ *  - aktarılmamış yazma sayısı eşiğe ulaştıysa,
+ *  - diske_aktar(), sabit_birak() veya kapat() çağrıldıysa,
+ *  - dosyaya satır/yama/kopya gibi flash üzerinde çalışan başka bir işlem yapılacaksa.
+ * Güç kesilirse son aktarmadan sonraki yazmalar kaybolur; sayaç, son durum gibi
+ * sık değişen küçük dosyalar için kullanılmalıdır.
+ *
+ * @param isim Dosya yolu (dosyanın var olması gerekmez)
+ * @param maxBoyut RAM'de tutulacak en fazla boyut; aşan yazmalar doğrudan flash'a gider
+ * @return true Dosya sabitlendiyse (veya zaten sabitse), false tablo doluysa, dosya büyükse veya günlüklüyse
+ */
+bool dosya_sistemi::sabitle(const char *isim, uint16_t maxBoyut)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    sabit_kaydi *s = sabit_bul(isim);
+    if (s)
+    {
+        s->maxBoyut = maxBoyut;
+        return true;
+    }
+    if (gunluk_bul(isim))
+        return false; // günlüklü dosya sabitlenemez
+
+    for (uint8_t i = 0; i < DEPO_SABIT_SAYISI; i++)
+    {
+        if (_sabitler[i].yol != 0)
+            continue;
+        s = &_sabitler[i];
+        s->isim = isim;
+        s->maxBoyut = maxBoyut;
+        s->kirli = false;
+        s->aktariliyor = false;
+        s->degisiklik = 0;
+        sabit_yenile(*s);
+        if (!s->yuklu)
+        {
+            s->isim = "";
+            return false; // dosya maxBoyut'tan büyük
+        }
+        yol_kilidi::kritik_gir();
+        s->yol = yol_ozeti(isim);
+        _sabitAdet++;
+        yol_kilidi::kritik_cik();
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Dosyayı önbellekten çıkarır; kirliyse önce flash'a yazar.
+ *
+ * @param isim Dosya yolu
+ * @return true Dosya sabitti ve (gerekiyorsa) aktarıldı
+ */
+bool dosya_sistemi::sabit_birak(const char *isim)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    sabit_kaydi *s = sabit_bul(isim);
+    if (!s)
+        return false;
+    bool tamam = sabit_diske_yaz(*s);
+    yol_kilidi::kritik_gir();
+    s->yol = 0;
+    _sabitAdet--;
+    yol_kilidi::kritik_cik();
+    s->isim = "";
+    s->icerik = ""; // RAM'i geri ver
+    return tamam;
+}
+
+/**
+ * @brief Kirli sabit dosyaların aktarma koşullarını ayarlar.
+ *
+ * @param sureMs İlk aktarılmamış yazmadan sonra dongu()'nün aktarma yapacağı süre
+ * @param degisiklikEsigi Bu kadar RAM yazmasından sonra hemen aktarılır (0: eşik yok)
+ */
+void dosya_sistemi::sabit_ayarla(uint32_t sureMs, uint16_t degisiklikEsigi)
+{
+    _sabitSure = sureMs;
+    _sabitEsik = degisiklikEsigi;
+}
+
+/**
+ * @brief Kirli sabit dosyaları hemen flash'a yazar (flush).
+ *
+ * @param isim Yalnızca bu dosya; nullptr ise tüm sabit dosyalar
+ * @return true Tüm aktarmalar başarılıysa
+ */
+bool dosya_sistemi::diske_aktar(const char *isim)
+{
+    if (isim)
+    {
+        yol_kilidi kilit(isim, true);
+        sabit_kaydi *s = sabit_bul(isim);
+        return kilit.tamam() && (!s || sabit_diske_yaz(*s));
+    }
+
+    bool tamam = true;
+    for (uint8_t i = 0; i < DEPO_SABIT_SAYISI && _sabitAdet > 0; i++)
+    {
+        sabit_kaydi &s = _sabitler[i];
+        if (s.yol == 0 || !s.kirli)
+            continue;
+        yol_kilidi kilit(s.isim.c_str(), true);
+        tamam &= kilit.tamam() && sabit_diske_yaz(s);
+    }
+    return tamam;
+}
+
+/**
+ * @brief Süresi dolan kirli sabit dosyaları flash'a yazar.
+ *
+ * loop() içinden sık sık çağrılmalıdır; kirli dosya yoksa hiçbir şey yapmaz.
+ */
+void dosya_sistemi::dongu()
+{
+    if (_sabitAdet == 0)
+        return;
+    uint32_t simdi = millis();
+    for (uint8_t i = 0; i < DEPO_SABIT_SAYISI; i++)
+    {
+        sabit_kaydi &s = _sabitler[i];
+        if (s.yol == 0 || !s.kirli || simdi - s.kirliZaman < _sabitSure)
+            continue;
+        yol_kilidi kilit(s.isim.c_str(), true);
+        if (kilit.tamam())
+            sabit_diske_yaz(s, &_sabitIstatistik.sureden);
+    }
+}
+
+/**
+ * @brief Yolu sabit dosya tablosunda arar.
+ *
+ * Sabit dosya yoksa yol özeti bile hesaplanmaz; böylece önbellek
+ * kullanılmadığında diğer fonksiyonlara ek maliyet gelmez.
+ */
+dosya_sistemi::sabit_kaydi *dosya_sistemi::sabit_bul(const char *isim)
+{
+    if (_sabitAdet == 0)
+        return nullptr;
+    uint32_t ozet = yol_ozeti(isim);
+    for (uint8_t i = 0; i < DEPO_SABIT_SAYISI; i++)
+    {
+        if (_sabitler[i].yol == ozet && _sabitler[i].isim == isim)
+            return &_sabitler[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Flash üzerinde çalışacak bir işlemden önce çağrılır.
+ *
+ * Dosya sabit ve kirliyse RAM'deki hali yazma kilidi alınarak flash'a yazılır.
+ * Flash'taki dosyayı doğrudan değiştiren veya kopyalayan işlemler çağırır;
+ * okuyan fonksiyonlar aktarmaz, RAM kopyasından okur. Çağıran aynı
+ * yuvada zaten okuma kilidi tutuyorsa aktarma yapılmaz: kilit yükseltilemez
+ * (bkz. yol_kilidi::al). Günlüğe dokunmaz; tabanı yerinde değiştiren işlemler
+ * ayrıca gunluk_isle() çağırır.
+ */
+void dosya_sistemi::sabit_aktar(const char *isim)
+{
+    if (_sabitAdet == 0 || yol_kilidi::okuyor(isim))
+        return;
+    {
+        yol_kilidi kilit(isim, false);
+        sabit_kaydi *s = sabit_bul(isim);
+        if (!s || !s->kirli)
+            return; // temiz dosya için okuyucuları bekletecek yazma kilidi alınmaz
+    }
+    yol_kilidi kilit(isim, true);
+    sabit_kaydi *s = sabit_bul(isim);
+    if (s && kilit.tamam())
+        sabit_diske_yaz(*s);
+}
+
+/**
+ * @brief Sabit dosyanın RAM'deki halini flash'a yazar.
+ *
+ * Dosya yeniden yazıldığı için çağıran yazma kilidini tutmalıdır. Flash'taki
+ * içerik zaten aynıysa yazılmaz (bkz. icerik_ayni). Yazılamazsa dosya kirli kalır.
+ * İstatistikler yalnızca flash'a başarıyla yapılan yazmayı sayar.
+ *
+ * @param s Sabit dosya kaydı
+ * @param sebep Yazma olursa ayrıca artırılacak sayaç (sureden/esikten), yoksa nullptr
+ * @return true Dosya kirli değildi veya başarıyla yazıldı
+ */
+bool dosya_sistemi::sabit_diske_yaz(sabit_kaydi &s, uint32_t *sebep)
+{
+    if (!s.kirli)
+        return true;
+    s.aktariliyor = true; // dosya_degisti() RAM kopyasını yeniden yüklemesin
+
+    const char *isim = s.isim.c_str();
+    uint32_t crc;
+    bool tamam = true;
+    if (!icerik_ayni(isim, s.icerik, crc))
+    {
+        uint32_t eskiBoyut = sayac_boyut(isim);
+        File dosya = _depo.open(isim, "w");
+        tamam = dosya && dosya.print(s.icerik) == s.icerik.length();
+        if (dosya)
+            dosya.close();
+        dosya_degisti(isim, (int32_t)s.icerik.length() - (int32_t)eskiBoyut);
+        if (tamam)
+        {
+            ozet_kaydet(isim, s.icerik.length(), crc);
+            yol_kilidi::kritik_gir();
+            _sabitIstatistik.aktarma++;
+            _sabitIstatistik.aktarilan_bayt += s.icerik.length();
+            if (sebep)
+                (*sebep)++;
+            yol_kilidi::kritik_cik();
+        }
+    }
+
+    yol_kilidi::kritik_gir();
+    if (tamam)
+    {
+        s.kirli = false;
+        s.degisiklik = 0;
+    } // yazılamadıysa kirli kalır, sonraki aktarmada tekrar denenir
+    s.aktariliyor = false;
+    yol_kilidi::kritik_cik();
+    return tamam;
+}
+
+/**
+ * @brief Sabit dosyanın RAM kopyasını flash'tan yeniden yükler.
+ *
+ * Dosya önbellek dışında değiştiğinde dosya_degisti() tarafından çağrılır.
+ * Dosya maxBoyut'tan büyükse kopya geçersiz sayılır ve okumalar flash'tan yapılır.
+ */
+void dosya_sistemi::sabit_yenile(sabit_kaydi &s)
+{
+    s.kirli = false;
+    s.degisiklik = 0;
+    s.icerik = "";
+    File dosya = _depo.open(s.isim.c_str(), "r");
+    s.var = dosya && !dosya.isDirectory();
+    s.yuklu = !dosya || (s.var && dosya.size() <= s.maxBoyut);
+    if (s.var && s.yuklu)
+    {
+        uint8_t tampon[DEPO_TAMPON];
+        s.icerik.reserve(dosya.size());
+        while (dosya.available())
+        {
+            size_t n = dosya.read(tampon, sizeof(tampon));
+            if (n == 0)
+                break;
+            s.icerik.concat((const char *)tampon, n);
+        }
+    }
+    if (dosya)
+        dosya.close();
+}
+
+/**
+ * @brief yaz/degistir/ekle/temizle çağrısını sabit dosyanın RAM kopyasına uygular.
+ *
+ * Çağıran, dosyanın yazma kilidini tutmalıdır.
+ *
+ * @param isim Dosya yolu
+ * @param veri Yeni içerik veya sona eklenecek kısım
+ * @param sonaEkle true ise `veri` sona eklenir
+ * @return true RAM'de karşılandıysa, false dosya sabit değil veya maxBoyut aşılıyorsa
+ */
+bool dosya_sistemi::sabite_yaz(const char *isim, const String &veri, bool sonaEkle)
+{
+    sabit_kaydi *s = sabit_bul(isim);
+    if (!s || !s->yuklu)
+        return false;
+    uint32_t yeniBoyut = veri.length() + (sonaEkle ? s->icerik.length() : 0);
+    if (yeniBoyut > s->maxBoyut)
+    {
+        sabit_diske_yaz(*s); // flash'taki işlem güncel içerikten devam etsin
+        return false;
+    }
+
+    bool degisti = !s->var || (sonaEkle ? veri.length() > 0 : s->icerik != veri);
+    if (sonaEkle)
+        s->icerik += veri;
+    else if (degisti)
+        s->icerik = veri;
+    bloom_kaydi *b = degisti ? bloom_bul(isim) : nullptr;
+    if (b)
+        b->eski = true; // aktarma süzgeci eskitmez; değişiklik burada işlenir
+
+    yol_kilidi::kritik_gir();
+    _sabitIstatistik.ram_yazma++;
+    s->var = true;
+    if (degisti)
+    {
+        if (!s->kirli)
+            s->kirliZaman = millis();
+        s->kirli = true;
+        s->degisiklik++;
+    }
+    bool esik = _sabitEsik != 0 && s->degisiklik >= _sabitEsik;
+    yol_kilidi::kritik_cik();
+
+    if (esik)
+        sabit_diske_yaz(*s, &_sabitIstatistik.esikten);
+    return true;
+}
+
+/**
+ * @brief Sabit dosyanın içeriğini veya boyutunu RAM'den verir.
+ *
+ * @param isim Dosya yolu
+ * @param icerik Dosya içeriği (isteğe bağlı)
+ * @param boyut Dosya boyutu, dosya yoksa -1 (isteğe bağlı)
+ * @return true RAM'den karşılandıysa
+ */
+bool dosya_sistemi::sabitten_oku(const char *isim, String *icerik, int32_t *boyut)
+{
+    sabit_kaydi *s = sabit_bul(isim);
+    if (!s || !s->yuklu)
+        return false;
+    if (icerik)
+        *icerik = s->icerik;
+    if (boyut)
+        *boyut = s->var ? (int32_t)s->icerik.length() : -1;
+    yol_kilidi::kritik_gir();
+    _sabitIstatistik.ram_okuma++;
+    yol_kilidi::kritik_cik();
+    return true;
+}
+
+/**
+ * @brief Sabit dosyanın RAM kopyasını kopyalamadan verir.
+ *
+ * Okuyan fonksiyonlar kirli sabit dosyayı flash'a aktarmak yerine bunu
+ * kullanır. Kopya yalnızca yazma kilidi altında değiştiği için çağıran,
+ * dosyanın okuma kilidini tuttuğu sürece gösterici geçerlidir.
+ *
+ * @return const String* İçerik, dosya sabit değil, yüklü değil veya yoksa nullptr
+ */
+const String *dosya_sistemi::sabit_icerik(const char *isim)
+{
+    sabit_kaydi *s = sabit_bul(isim);
+    if (!s || !s->yuklu || !s->var)
+        return nullptr;
+    yol_kilidi::kritik_gir();
+    _sabitIstatistik.ram_okuma++;
+    yol_kilidi::kritik_cik();
+    return &s->icerik;
+}
+
+/**
+ * @brief Sabit dosyanın satır aralığını RAM kopyasından verir.
+ *
+ * gunluk_oku() ile aynı biçimde çalışır: her satır '\n' ile biter. Flash'a
+ * dokunulmaz. Çağıran, dosyanın okuma kilidini tutmalıdır.
+ *
+ * @return int8_t 1: RAM'den verildi, -1: dosya RAM'den okunamıyor (bkz. sabit_icerik)
+ */
+int8_t dosya_sistemi::sabit_oku(const char *isim, uint32_t ilk, uint32_t son, aktar_fn fn, void *veri)
+{
+    static const uint8_t satirSonu = '\n';
+    const String *icerik = sabit_icerik(isim);
+    if (!icerik)
+        return -1;
+    const char *p = icerik->c_str();
+    size_t uzunluk = icerik->length();
+    size_t bas = 0;
+    for (uint32_t satir = 0; bas < uzunluk && satir <= son; satir++)
+    {
+        const char *bulunan = (const char *)memchr(p + bas, '\n', uzunluk - bas);
+        size_t bitis = bulunan ? bulunan - p + 1 : uzunluk;
+        if (satir >= ilk && (!fn((const uint8_t *)p + bas, bitis - bas, veri) || (!bulunan && !fn(&satirSonu, 1, veri))))
+            break;
+        bas = bitis;
+    }
+    return 1;
+}
+
+/**
+ * @brief Sabit dosyanın satır sayısını RAM kopyasından sayar (bkz. satir_hesap).
+ *
+ * @return int32_t Satır sayısı, dosya RAM'den okunamıyorsa -1
+ */
+int32_t dosya_sistemi::sabit_satir_sayisi(const char *isim)
+{
+    const String *icerik = sabit_icerik(isim);
+    if (!icerik)
+        return -1;
+    int32_t satirSayisi = 0;
+    for (size_t i = 0; i < icerik->length(); i++)
+        satirSayisi += (*icerik)[i] == '\n';
+    if (icerik->length() > 0 && !icerik->endsWith("\n"))
+        satirSayisi++; // sonunda satır sonu olmayan son satır
+    return satirSayisi;
+}
@@ -2,6 +2,777 @@
 
 #define __TEST 0
 
+#if __TEST == 1
+
+#define FARK_MAX_SATIR 48 // fark testinde modelin tutabileceği en fazla satır
+
+/**
+ * @brief Satır fonksiyonlarının RAM'deki karşılığı (referans model).
+ *
+ * Fark testi her işlemi hem dosyaya hem bu modele uygular ve sonuçları karşılaştırır.
+ */
+struct satir_modeli
+{
+    String satirlar[FARK_MAX_SATIR];
+    uint16_t adet = 0;
+
+    void ekle(uint16_t konum, const String &s)
+    {
+        if (adet >= FARK_MAX_SATIR)
+            return;
+        if (konum > adet)
+            konum = adet;
+        for (uint16_t i = adet; i > konum; i--)
+            satirlar[i] = satirlar[i - 1];
+        satirlar[konum] = s;
+        adet++;
+    }
+
+    void sil(uint16_t ilk, uint16_t son)
+    {
+        if (ilk >= adet)
+            return;
+        if (son >= adet)
+            son = adet - 1;
+        uint16_t n = son - ilk + 1;
+        for (uint16_t i = ilk; i + n < adet; i++)
+            satirlar[i] = satirlar[i + n];
+        adet -= n;
+    }
+
+    String icerik(uint16_t ilk = 0, uint16_t son = 0xFFFE) const
+    {
+        String s = "";
+        for (uint16_t i = ilk; i < adet && i <= son; i++)
+            s += satirlar[i] + "\n";
+        return s;
+    }
+};
+
+static bool eslesme_say(const String &yol, uint32_t satir, uint32_t konum, void *veri)
+{
+    (void)yol;
+    (void)satir;
+    (void)konum;
+    ++*(uint32_t *)veri;
+    return true;
+}
+
+static String rastgele_satir()
+{
+    static const char *const ornekler[] = {"", "a", "const uint8_t veri", "satir: 12345", " ", "x,y,z"};
+    return String(ornekler[random(6)]) + (random(3) == 0 ? String(random(1000)) : String(""));
+}
+
+/**
+ * @brief Satır fonksiyonlarını rastgele işlem dizileriyle modele karşı dener.
+ *
+ * ekle, satir_ekle, satir_sil, satir_degistir, sil(aralık) ve oku(aralık)
+ * rastgele sırayla çağrılır. Her adımdan sonra satir_hesap, oku ve satir_oku
+ * sonuçları modelle karşılaştırılır; ilk farkta tohum ve adım yazdırılır.
+ */
+static bool fark_testi(dosya_sistemi &fs, uint32_t tohum, uint16_t adim)
+{
+    const char *isim = "/__fark__.txt";
+    satir_modeli model;
+    randomSeed(tohum);
+    fs.temizle(isim);
+
+    for (uint16_t a = 0; a < adim; a++)
+    {
+        uint8_t islem = random(6);
+        uint16_t k = random(model.adet + 2);
+        uint16_t k2 = k + random(4);
+        String s = rastgele_satir();
+        String beklenen = "";
+        String okunan = "";
+
+        switch (islem)
+        {
+        case 0:
+            if (model.adet >= FARK_MAX_SATIR)
+                continue;
+            fs.ekle(isim, s + "\n");
+            model.ekle(model.adet, s);
+            break;
+        case 1:
+            if (model.adet >= FARK_MAX_SATIR)
+                continue;
+            fs.satir_ekle(isim, k, s);
+            model.ekle(k, s);
+            break;
+        case 2:
+            fs.satir_sil(isim, k);
+            model.sil(k, k);
+            break;
+        case 3:
+            fs.satir_degistir(isim, k, s);
+            if (k < model.adet)
+                model.satirlar[k] = s;
+            break;
+        case 4:
+            fs.sil(isim, k, k2);
+            model.sil(k, k2);
+            break;
+        case 5:
+            beklenen = k < model.adet ? model.icerik(k, k2) : String("");
+            okunan = fs.oku(isim, k, k2);
+            break;
+        }
+
+        int16_t satir = random(model.adet + 1);
+        bool hata = okunan != beklenen ||
+                    fs.satir_hesap(isim) != model.adet ||
+                    fs.oku(isim) != model.icerik() ||
+                    fs.satir_oku(isim, satir) != (satir < model.adet ? model.satirlar[satir] : String(""));
+        if (hata)
+        {
+            Serial.printf("\nFARK: tohum=%lu adim=%u islem=%u k=%u k2=%u\n", (unsigned long)tohum, a, islem, k, k2);
+            return false;
+        }
+    }
+    fs.sil(isim);
+    return true;
+}
+
+/**
+ * @brief Günlüklü satır düzenlemeyi günlüksüz dosyaya karşı dener.
+ *
+ * Aynı rastgele işlem dizisi biri günlüksüz, biri gunluk_ac() ile açılmış iki
+ * dosyaya uygulanır. ekle() ile sonunda satır sonu olmayan dosyalar da üretilir,
+ * aynı uzunlukta satir_degistir de denenir; eşik küçük tutulur ki tabana işleme
+ * de sınansın. Her adımdan sonra oku, satir_hesap, satir_oku, oku(aralık),
+ * son_satirlar, boyut, oku_konumdan ve ara karşılaştırılır; bu okumaların
+ * günlük dosyasına dokunmadığı da denetlenir. Sonunda günlük kapatılıp iki
+ * dosyanın içeriği karşılaştırılır. İlk farkta tohum ve adım yazdırılır.
+ */
+static bool gunluk_fark_testi(dosya_sistemi &fs, uint32_t tohum, uint16_t adim)
+{
+    const char *dosyalar[2] = {"/__fark_duz__.txt", "/__fark_gunluk__.txt"};
+    String gunlukAdi = String(dosyalar[1]) + ".jrn";
+    randomSeed(tohum);
+    for (uint8_t d = 0; d < 2; d++)
+        fs.yaz(dosyalar[d], "a\nb");
+    fs.gunluk_ac(dosyalar[1], 64 + random(256));
+
+    for (uint16_t a = 0; a <= adim; a++)
+    {
+        uint8_t islem = random(8);
+        uint32_t satirSayisi = fs.satir_hesap(dosyalar[0]);
+        uint32_t k = random(satirSayisi + 2);
+        String s = rastgele_satir();
+        if (islem == 3)
+        {
+            s = fs.satir_oku(dosyalar[0], k); // aynı uzunluk: yerinde yazılır
+            if (s.length() > 0)
+                s.setCharAt(0, '#');
+        }
+
+        for (uint8_t d = 0; d < 2 && a < adim; d++)
+        {
+            switch (islem)
+            {
+            case 0: fs.satir_ekle(dosyalar[d], k, s); break;
+            case 1: fs.satir_sil(dosyalar[d], k); break;
+            case 2:
+            case 3: fs.satir_degistir(dosyalar[d], k, s); break;
+            case 4: fs.ekle(dosyalar[d], s); break; // satır sonu olmadan
+            case 5: fs.ekle(dosyalar[d], s + "\n"); break;
+            case 6: fs.sil(dosyalar[d], k, k + 1); break;
+            case 7: fs.satir_degistir(dosyalar[d], k, s + "x"); break;
+            }
+        }
+        if (a == adim)
+            fs.gunluk_kapat(dosyalar[1]); // son karşılaştırma tabana işlenmiş dosyayla
+
+        uint32_t satir = random(satirSayisi + 1);
+        uint32_t bayt = random(fs.boyut(dosyalar[0]) + 1);
+        int32_t gunlukBoyutu = fs.boyut(gunlukAdi.c_str());
+        bool hata = fs.oku(dosyalar[0]) != fs.oku(dosyalar[1]) ||
+                    fs.satir_hesap(dosyalar[0]) != fs.satir_hesap(dosyalar[1]) ||
+                    fs.satir_oku(dosyalar[0], satir) != fs.satir_oku(dosyalar[1], satir) ||
+                    fs.oku(dosyalar[0], satir, satir + 2) != fs.oku(dosyalar[1], satir, satir + 2) ||
+                    fs.son_satirlar(dosyalar[0], 2) != fs.son_satirlar(dosyalar[1], 2) ||
+                    fs.boyut(dosyalar[0]) != fs.boyut(dosyalar[1]) ||
+                    fs.oku_konumdan(dosyalar[0], bayt) != fs.oku_konumdan(dosyalar[1], bayt) ||
+                    fs.ara(dosyalar[0], s) != fs.ara(dosyalar[1], s) ||
+                    fs.boyut(gunlukAdi.c_str()) != gunlukBoyutu; // okumalar günlüğü tabana işlememeli
+        if (hata)
+        {
+            Serial.printf("\nGÜNLÜK FARKI: tohum=%lu adim=%u islem=%u k=%lu\n", (unsigned long)tohum, a, islem,
+                          (unsigned long)k);
+            fs.gunluk_kapat(dosyalar[1]);
+            return false;
+        }
+    }
+    fs.sil(dosyalar[0]);
+    fs.sil(dosyalar[1]);
+    return true;
+}
+
+/**
+ * @brief Satır fonksiyonlarının hızını ölçer.
+ *
+ * Her dosya boyutunda her işlem birkaç kez çağrılır; saniyedeki işlem sayısı ve
+ * işlem başına flash'a yazılan tahmini bayt (tüm dosyayı yeniden yazan işlemler
+ * için dosya boyutu, ekle ve yerinde yama için yazılan bayt) yazdırılır.
+ * "satir_yama" aynı uzunlukta satir_degistir'dir ve yerinde yazılır.
+ */
+static void hiz_testi(dosya_sistemi &fs)
+{
+    const char *isim = "/__hiz__.txt";
+    const uint16_t boyutlar[] = {100, 1000};
+    const char *const adlar[] = {"ekle", "satir_ekle", "satir_sil", "satir_degistir", "sil(aralik)", "oku(aralik)",
+                                 "satir_yama"};
+    const uint8_t tekrar = 5;
+
+    for (uint8_t b = 0; b < sizeof(boyutlar) / sizeof(boyutlar[0]); b++)
+    {
+        String icerik = "";
+        for (uint16_t i = 0; i < boyutlar[b]; i++)
+            icerik += String(F("olcum satiri ")) + String(i) + "\n";
+        fs.yaz(isim, icerik);
+        uint16_t orta = boyutlar[b] / 2;
+        String ayniUzunluk = fs.satir_oku(isim, orta);
+        ayniUzunluk.setCharAt(0, 'O');
+
+        Serial.printf("--- %u satir, %lu bayt ---\n", boyutlar[b], (unsigned long)icerik.length());
+        for (uint8_t islem = 0; islem < 7; islem++)
+        {
+            uint32_t yazilan = 0;
+            uint32_t bas = micros();
+            for (uint8_t t = 0; t < tekrar; t++)
+            {
+                switch (islem)
+                {
+                case 0: fs.ekle(isim, "olcum satiri ek\n"); yazilan += 16; continue;
+                case 1: fs.satir_ekle(isim, orta, "olcum satiri ek"); break;
+                case 2: fs.satir_sil(isim, orta); break;
+                case 3: fs.satir_degistir(isim, orta, "olcum satiri degisti"); break;
+                case 4: fs.sil(isim, orta, orta); break;
+                case 5: fs.oku(isim, orta, orta + 10); continue;
+                case 6: fs.satir_degistir(isim, orta, ayniUzunluk); yazilan += ayniUzunluk.length(); continue;
+                }
+                yazilan += fs.boyut(isim);
+            }
+            uint32_t sure = micros() - bas;
+            Serial.printf("%-15s %8.1f islem/s %8lu bayt/islem\n", adlar[islem],
+                          sure ? tekrar * 1e6f / sure : 0.0f, (unsigned long)(yazilan / tekrar));
+        }
+    }
+    fs.sil(isim);
+}
+
+/**
+ * @brief satirlar() yineleyicisini satır başına String oluşturan döngüyle karşılaştırır.
+ *
+ * Dosyada tampondan uzun satırlar ve boş satırlar da bulunur. İki yöntemin
+ * süresi yazdırılır; satır sayısı ve toplam uzunluk eşit değilse HATA yazılır.
+ */
+static void yineleyici_testi(dosya_sistemi &fs)
+{
+    const char *isim = "/__yineleyici__.txt";
+    const uint16_t boyutlar[] = {1000, 10000};
+
+    for (uint8_t b = 0; b < sizeof(boyutlar) / sizeof(boyutlar[0]); b++)
+    {
+        fs.temizle(isim);
+        String blok = "";
+        for (uint16_t i = 0; i < boyutlar[b]; i++)
+        {
+            if (i % 100 == 1)
+                for (uint8_t k = 0; k < 10; k++)
+                    blok += F("0123456789012345678901234567890"); // 310 bayt, tampondan uzun
+            if (i % 7 != 3)
+                blok += String(F("satir ")) + String(i);
+            blok += "\n";
+            if (blok.length() > 2048 || i + 1 == boyutlar[b])
+            {
+                fs.ekle(isim, blok);
+                blok = "";
+            }
+        }
+
+        uint32_t satirString = 0, baytString = 0;
+        uint32_t bas = micros();
+        File dosya = fs.depo().open(isim, "r");
+        String satir;
+        while (fs.satirOku(dosya, satir))
+        {
+            satirString++;
+            baytString += satir.length();
+        }
+        dosya.close();
+        uint32_t sureString = micros() - bas;
+
+        uint32_t satirGorunum = 0, baytGorunum = 0;
+        bas = micros();
+        for (const satir_gorunumu &s : fs.satirlar(isim))
+        {
+            satirGorunum += s.son;
+            baytGorunum += s.uzunluk;
+        }
+        uint32_t sureGorunum = micros() - bas;
+
+        Serial.printf("--- %u satir ---\nString/satir  %8lu us\nsatirlar()    %8lu us %s\n", boyutlar[b],
+                      (unsigned long)sureString, (unsigned long)sureGorunum,
+                      satirString == satirGorunum && baytString == baytGorunum ? "" : "HATA");
+    }
+    fs.sil(isim);
+}
+
+/**
+ * @brief Satır fonksiyonlarının dosya büyüdükçe nasıl ölçeklendiğini ölçer.
+ *
+ * 10^3'ten 10^6'ya kadar satırlı (satır başına 14 bayt) dosyalar oluşturulur;
+ * dosya ve yeniden yazma için gereken geçici kopya sığmıyorsa o boyut atlanır.
+ * Her işlem bir kez çağrılıp süresi (ms) yazdırılır. 32767'den fazla satırda
+ * satır numaralarının taşmadığı satir_hesap ile de doğrulanır.
+ */
+static void olcekleme_testi(dosya_sistemi &fs)
+{
+    const char *isim = "/__olcek__.txt";
+    const char *const adlar[] = {"satir_hesap", "satir_oku(son)", "oku(son 10)", "son_satirlar(10)", "ara(son)",
+                                 "satir_yama(orta)", "satir_ekle(orta)", "satir_sil(orta)"};
+    const uint16_t parca = 500; // ekle() başına satır
+
+    for (uint32_t adet = 1000; adet <= 1000000UL; adet *= 10)
+    {
+        uint32_t bayt = adet * 14;
+        Serial.printf("--- %lu satir, %lu bayt ---\n", (unsigned long)adet, (unsigned long)bayt);
+        if (fs.bos_alan() < (int32_t)(bayt * 2 + 8192))
+        {
+            Serial.println(F("Yer yok, atlandı"));
+            continue;
+        }
+
+        fs.temizle(isim);
+        char satir[18]; // en uzun: 10 basamaklı uint32_t + " olcum\n" + '\0'
+        for (uint32_t i = 0; i < adet; i += parca)
+        {
+            String blok = "";
+            blok.reserve(parca * 14);
+            for (uint32_t j = i; j < i + parca && j < adet; j++)
+            {
+                snprintf(satir, sizeof(satir), "%07lu olcum\n", (unsigned long)j);
+                blok += satir;
+            }
+            fs.ekle(isim, blok);
+        }
+        uint32_t orta = adet / 2;
+        snprintf(satir, sizeof(satir), "%07lu olcum", (unsigned long)(adet - 1));
+        String sonSatir = satir;
+        snprintf(satir, sizeof(satir), "%07lu OLCUM", (unsigned long)orta);
+        String yama = satir;
+
+        for (uint8_t islem = 0; islem < 8; islem++)
+        {
+            bool dogru = true;
+            uint32_t bas = millis();
+            switch (islem)
+            {
+            case 0: dogru = fs.satir_hesap(isim) == (int32_t)adet; break;
+            case 1: dogru = fs.satir_oku(isim, adet - 1) == sonSatir; break;
+            case 2: dogru = fs.oku(isim, satir_araligi::sona_kadar(adet - 10)).length() == 140; break;
+            case 3: dogru = fs.son_satirlar(isim, 10).length() == 140; break;
+            case 4: dogru = fs.ara(isim, sonSatir) == (int32_t)(adet - 1); break;
+            case 5: dogru = fs.satir_degistir(isim, orta, yama); break;
+            case 6: dogru = fs.satir_ekle(isim, orta, "ek"); break;
+            case 7: dogru = fs.satir_sil(isim, orta) && fs.satir_oku(isim, orta) == yama; break;
+            }
+            Serial.printf("%-18s %8lu ms %s\n", adlar[islem], (unsigned long)(millis() - bas), dogru ? "" : "HATA");
+        }
+    }
+    fs.sil(isim);
+}
+
+/**
+ * @brief Yazılan baytları yalnızca sayan Print hedefi (aktarma hızını ölçmek için).
+ */
+class sayan_cikti : public Print
+{
+public:
+    uint32_t bayt = 0;
+    size_t write(uint8_t) override
+    {
+        bayt++;
+        return 1;
+    }
+    size_t write(const uint8_t *, size_t uzunluk) override
+    {
+        bayt += uzunluk;
+        return uzunluk;
+    }
+};
+
+/**
+ * @brief aktar() ile oku()'nun hızını ve ayırdığı belleği karşılaştırır.
+ *
+ * 60 KB'lık (4096 satır) bir dosya önce oku() ile tek String'e, sonra aktar() ile
+ * RAM'de tutulan sayan bir hedefe okunur; ardından son 1000 satır ve
+ * ortadaki 4 KB'lık bayt aralığı aktarılır. Süreler ve hızlar yazdırılır.
+ */
+static void aktarma_testi(dosya_sistemi &fs)
+{
+    const char *isim = "/__aktar__.txt";
+    fs.temizle(isim);
+    String blok = "";
+    for (uint16_t i = 0; i < 4096; i++)
+    {
+        char satir[17];
+        snprintf(satir, sizeof(satir), "%014u\n", i); // 15 bayt
+        blok += satir;
+        if (i % 256 == 255)
+        {
+            fs.ekle(isim, blok);
+            blok = "";
+        }
+    }
+
+    uint32_t bas = micros();
+    uint32_t okunan = fs.oku(isim).length();
+    uint32_t sureOku = micros() - bas;
+
+    sayan_cikti hedef;
+    bas = micros();
+    int32_t aktarilan = fs.aktar(isim, hedef);
+    uint32_t sureAktar = micros() - bas;
+
+    sayan_cikti satirlar;
+    int32_t sonSatirlar = fs.aktar(isim, satirlar, satir_araligi::sona_kadar(4096 - 1000));
+    sayan_cikti aralik;
+    int32_t orta = fs.aktar(isim, aralik, 30000, 4096);
+
+    Serial.printf("oku()   %lu bayt %8lu us (%lu KB/s, dosya kadar RAM)\n", (unsigned long)okunan, (unsigned long)sureOku,
+                  (unsigned long)(sureOku ? okunan * 1000UL / 1024 * 1000 / sureOku : 0));
+    Serial.printf("aktar() %lu bayt %8lu us (%lu KB/s, %u bayt tampon) %s\n", (unsigned long)hedef.bayt,
+                  (unsigned long)sureAktar, (unsigned long)(sureAktar ? hedef.bayt * 1000UL / 1024 * 1000 / sureAktar : 0),
+                  DEPO_AKTAR_TAMPON, aktarilan == (int32_t)okunan && hedef.bayt == okunan ? "" : "HATA");
+    Serial.printf("son 1000 satır %ld bayt, 30000+4096 aralığı %ld bayt %s\n", (long)sonSatirlar, (long)orta,
+                  sonSatirlar == 15000 && orta == 4096 ? "" : "HATA");
+    fs.sil(isim);
+}
+
+/**
+ * @brief agacta_ara()'nın çok dosyalı bir ağaçtaki tarama hızını ölçer.
+ *
+ * 4 klasörde 5'er dosya (her biri 200 satır, 3.6 KB) oluşturulur; her 50
+ * satırdan biri "const" içerir. Ağaçta "const" aranır, bulunan eşleşme
+ * beklenenle karşılaştırılır ve taranan bayt ile hız yazdırılır.
+ */
+static void agac_arama_testi(dosya_sistemi &fs)
+{
+    const char *kok = "/__agac__";
+    fs.dizin_olustur(kok);
+    uint32_t toplam = 0;
+    uint16_t dosyaSayisi = 0;
+    for (uint8_t d = 0; d < 4; d++)
+    {
+        String dizin = String(kok) + "/d" + String(d);
+        fs.dizin_olustur(dizin.c_str());
+        for (uint8_t f = 0; f < 5; f++)
+        {
+            String yol = dizin + "/f" + String(f) + ".txt";
+            String blok = "";
+            for (uint16_t i = 0; i < 200; i++)
+            {
+                char satir[24];
+                snprintf(satir, sizeof(satir), i % 50 == 49 ? "kayit-%05u const\n" : "kayit-%05u deger\n", i);
+                blok += satir;
+            }
+            fs.yaz(yol.c_str(), blok);
+            toplam += blok.length();
+            dosyaSayisi++;
+        }
+    }
+
+    uint32_t eslesme = 0;
+    uint32_t bas = micros();
+    uint32_t bulunan = fs.agacta_ara(kok, "const", eslesme_say, &eslesme);
+    uint32_t sure = micros() - bas;
+    Serial.printf("%u dosya, %lu bayt, %lu eşleşme, %lu us (%lu KB/s) %s\n", dosyaSayisi, (unsigned long)toplam,
+                  (unsigned long)bulunan, (unsigned long)sure,
+                  (unsigned long)(sure ? toplam * 1000UL / 1024 * 1000 / sure : 0),
+                  bulunan == dosyaSayisi * 4UL && eslesme == bulunan ? "" : "HATA");
+
+    for (uint8_t d = 0; d < 4; d++)
+    {
+        String dizin = String(kok) + "/d" + String(d);
+        for (uint8_t f = 0; f < 5; f++)
+            fs.sil((dizin + "/f" + String(f) + ".txt").c_str());
+        fs.depo().rmdir(dizin.c_str());
+    }
+    fs.depo().rmdir(kok);
+}
+
+/**
+ * @brief Bloom süzgecinin olmayan satır aramalarını ne kadar kısalttığını ölçer.
+ *
+ * 2000 cihaz kimliği içeren bir dosyada önce süzgeçsiz, sonra süzgeçli olarak
+ * 200 olmayan ve 20 var olan kimlik aranır; sonuçlar karşılaştırılır ve
+ * ölçülen atlama / yanlış pozitif oranları yazdırılır.
+ */
+static void bloom_testi(dosya_sistemi &fs)
+{
+    const char *isim = "/__bloom__.txt";
+    fs.temizle(isim);
+    String blok = "";
+    for (uint16_t i = 0; i < 2000; i++)
+    {
+        blok += F("cihaz-");
+        blok += i;
+        blok += '\n';
+        if (i % 250 == 249)
+        {
+            fs.ekle(isim, blok);
+            blok = "";
+        }
+    }
+
+    int32_t sonuclar[2][220];
+    uint32_t sureler[2];
+    for (uint8_t tur = 0; tur < 2; tur++)
+    {
+        if (tur == 1)
+            fs.bloom_ac(isim, 2000, 0.01f);
+        uint32_t bas = millis();
+        for (uint16_t i = 0; i < 220; i++)
+        {
+            // ilk 200 kimlik dosyada yok, son 20'si var
+            String aranan = F("cihaz-");
+            aranan += i < 200 ? 5000 + i : i * 9;
+            sonuclar[tur][i] = fs.ara(isim, aranan);
+        }
+        sureler[tur] = millis() - bas;
+    }
+
+    bloom_istatistik ist = fs.bloom_istatistikleri();
+    bool ayni = memcmp(sonuclar[0], sonuclar[1], sizeof(sonuclar[0])) == 0;
+    Serial.printf("süzgeçsiz %lu ms, süzgeçli %lu ms %s\n", (unsigned long)sureler[0], (unsigned long)sureler[1],
+                  ayni ? "" : "HATA");
+    Serial.printf("%lu sorgu, %lu atlandı (%%%lu), %lu yanlış pozitif, %lu yeniden kurma\n", (unsigned long)ist.sorgu,
+                  (unsigned long)ist.atlanan, (unsigned long)(ist.sorgu ? ist.atlanan * 100 / ist.sorgu : 0),
+                  (unsigned long)ist.yanlis_pozitif, (unsigned long)ist.yeniden_kurma);
+    fs.bloom_kapat(isim);
+    fs.sil(isim);
+}
+
+/**
+ * @brief Günlüklü satır düzenlemenin yazma hızını ve okumaya eklediği yükü ölçer.
+ *
+ * 2000 satırlık bir dosyada önce günlüksüz, sonra günlüklü olarak 200 satir_degistir()
+ * yapılır. Ardından günlükte 0/50/100/200 kayıt biriktirilerek satir_oku() ve
+ * 100 satırlık oku() aralığının süresi ölçülür; sonunda günlük tabana işlenir ve
+ * içerik günlüksüz kopyayla karşılaştırılır.
+ */
+static void gunluk_testi(dosya_sistemi &fs)
+{
+    const char *isimler[2] = {"/__gunluksuz__.txt", "/__gunluk__.txt"};
+    for (uint8_t tur = 0; tur < 2; tur++)
+    {
+        fs.temizle(isimler[tur]);
+        String blok = "";
+        for (uint16_t i = 0; i < 2000; i++)
+        {
+            char satir[16];
+            snprintf(satir, sizeof(satir), "satir-%05u\n", i);
+            blok += satir;
+            if (i % 250 == 249)
+            {
+                fs.ekle(isimler[tur], blok);
+                blok = "";
+            }
+        }
+    }
+    fs.gunluk_ac(isimler[1], 8192);
+
+    uint32_t sureler[2];
+    for (uint8_t tur = 0; tur < 2; tur++)
+    {
+        uint32_t bas = millis();
+        for (uint16_t i = 0; i < 200; i++)
+            fs.satir_degistir(isimler[tur], (i * 37) % 2000, String(F("degisti-")) + i);
+        sureler[tur] = millis() - bas;
+    }
+    Serial.printf("200 satir_degistir: günlüksüz %lu ms, günlüklü %lu ms\n", (unsigned long)sureler[0],
+                  (unsigned long)sureler[1]);
+
+    // okuma yükü: her ölçümden önce günlük boşaltılıp istenen sayıda kayıt biriktirilir
+    const uint16_t uzunluklar[] = {0, 50, 100, 200};
+    for (uint8_t u = 0; u < sizeof(uzunluklar) / sizeof(uzunluklar[0]); u++)
+    {
+        fs.gunluk_sikistir(isimler[1]);
+        for (uint16_t i = 0; i < uzunluklar[u]; i++)
+            fs.satir_degistir(isimler[1], (i * 53) % 2000, String(F("yeni-")) + i);
+
+        uint32_t bas = micros();
+        for (uint8_t i = 0; i < 20; i++)
+            fs.satir_oku(isimler[1], 1900 + i);
+        uint32_t sureSatir = micros() - bas;
+        bas = micros();
+        uint32_t okunan = fs.oku(isimler[1], 1000, 1099).length();
+        uint32_t sureAralik = micros() - bas;
+        Serial.printf("günlük %3u kayıt: satir_oku %6lu us/satır, oku(100 satır) %7lu us (%lu bayt)\n", uzunluklar[u],
+                      (unsigned long)(sureSatir / 20), (unsigned long)sureAralik, (unsigned long)okunan);
+
+        // günlüksüz kopyada da aynı düzenlemeler yapılır ki sonda içerikler karşılaştırılabilsin
+        for (uint16_t i = 0; i < uzunluklar[u]; i++)
+            fs.satir_degistir(isimler[0], (i * 53) % 2000, String(F("yeni-")) + i);
+    }
+
+    fs.gunluk_kapat(isimler[1]);
+    bool ayni = fs.oku(isimler[0]) == fs.oku(isimler[1]);
+    Serial.printf("tabana işlendikten sonra içerik %s\n", ayni ? "aynı" : "FARKLI - HATA");
+    fs.sil(isimler[0]);
+    fs.sil(isimler[1]);
+}
+
+#if DEPO_KILITLI
+#define KILIT_TESTI_TUR 300 // kilit testinde her yazan görevin yaptığı işlem sayısı
+
+struct kilit_testi_durumu
+{
+    dosya_sistemi *fs;
+    volatile uint8_t biten = 0;     // işini bitiren yazan görev sayısı
+    volatile uint8_t kapanan = 0;   // çıkan görev sayısı
+    volatile uint32_t okuma = 0;
+    volatile uint32_t hata = 0;
+};
+
+struct kilit_gorevi
+{
+    kilit_testi_durumu *d;
+    uint8_t tur;
+};
+
+static void kilit_say(volatile uint32_t &sayac)
+{
+    yol_kilidi::kritik_gir();
+    sayac++;
+    yol_kilidi::kritik_cik();
+}
+
+/**
+ * @brief Kilit testinin görev gövdesi; tur hangi işi yapacağını seçer.
+ *
+ * 0/1: düz ve günlüklü dosyada satir_degistir, 2: ekle, 3: sabit dosyaya yaz,
+ * 4/5: yazanlar bitene kadar okuyup satır sayısını ve içeriği denetler. Sabit
+ * dosya RAM kopyasından okunur; okuyan yarım içerik görmemelidir.
+ */
+static void kilit_gorevi_calistir(void *p)
+{
+    kilit_gorevi *g = (kilit_gorevi *)p;
+    kilit_testi_durumu *d = g->d;
+    dosya_sistemi &fs = *d->fs;
+    if (g->tur < 4)
+    {
+        for (uint16_t i = 0; i < KILIT_TESTI_TUR; i++)
+        {
+            if (g->tur == 0)
+                fs.satir_degistir("/__kilit_a__.txt", i % 10, String(F("degisti-")) + i);
+            else if (g->tur == 1)
+                fs.satir_degistir("/__kilit_g__.txt", (i * 7) % 10, String(F("gunluk-")) + i);
+            else if (g->tur == 2)
+                fs.ekle("/__kilit_e__.txt", String(F("ek\n")));
+            else
+                fs.yaz("/__kilit_s__.txt", String(i));
+        }
+        yol_kilidi::kritik_gir();
+        d->biten++;
+        yol_kilidi::kritik_cik();
+    }
+    else
+    {
+        while (d->biten < 4)
+        {
+            const char *isim = g->tur == 4 ? "/__kilit_a__.txt" : "/__kilit_g__.txt";
+            String icerik = fs.oku(isim);
+            uint16_t satir = 0;
+            for (uint32_t i = 0; i < icerik.length(); i++)
+                satir += icerik[i] == '\n';
+            if (fs.satir_hesap(isim) != 10 || satir != 10 || fs.satir_oku(isim, 9).length() == 0 ||
+                fs.oku("/__kilit_s__.txt").length() == 0 || fs.satir_hesap("/__kilit_s__.txt") != 1)
+                kilit_say(d->hata);
+            kilit_say(d->okuma);
+        }
+    }
+    yol_kilidi::kritik_gir();
+    d->kapanan++;
+    yol_kilidi::kritik_cik();
+    vTaskDelete(nullptr);
+}
+
+/**
+ * @brief aktar() geri çağrısından, yani okuma kilidi altında aynı dosyaya yazar.
+ *
+ * Yazma kilidi beklenirse görev kendini bekler; yazma hemen reddedilmelidir.
+ */
+static bool okurken_yaz(const uint8_t *, size_t, void *veri)
+{
+    kilit_testi_durumu *d = (kilit_testi_durumu *)veri;
+    if (d->fs->yaz("/__kilit_a__.txt", String(F("okurken yazildi\n"))))
+        kilit_say(d->hata);
+    return false;
+}
+
+/**
+ * @brief DEPO_KILITLI ile kütüphaneyi aynı anda çalışan görevlerden zorlar.
+ *
+ * Dört görev düz dosyada, günlüklü dosyada, ekleme ile ve RAM'e sabitlenmiş
+ * dosyada yazarken iki görev okur. Okuyan hiçbir zaman yarım yazılmış bir
+ * dosya görmemeli; sonda satır sayıları ve son yazılan değer denetlenir.
+ * Ardından okuma geri çağrısından yapılan yazmanın kilitlenmeden
+ * reddedildiği denetlenir.
+ */
+static void kilit_testi(dosya_sistemi &fs)
+{
+    String on = "";
+    for (uint16_t i = 0; i < 10; i++)
+        on += String(F("satir-")) + i + "\n";
+    fs.yaz("/__kilit_a__.txt", on);
+    fs.yaz("/__kilit_g__.txt", on);
+    fs.yaz("/__kilit_e__.txt", "");
+    fs.yaz("/__kilit_s__.txt", "0");
+    fs.gunluk_ac("/__kilit_g__.txt", 512);
+    fs.sabitle("/__kilit_s__.txt", 16);
+
+    kilit_testi_durumu d;
+    d.fs = &fs;
+    kilit_gorevi gorevler[6];
+    uint8_t baslayan = 0;
+    uint32_t bas = millis();
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        gorevler[i] = {&d, i};
+        if (xTaskCreate(kilit_gorevi_calistir, "depo_kilit", 8192, &gorevler[i], tskIDLE_PRIORITY + 1, nullptr) == pdPASS)
+            baslayan++;
+        else if (i < 4)
+            d.biten++; // başlamayan yazan beklenmesin
+    }
+    while (d.kapanan < baslayan)
+        vTaskDelay(10);
+    fs.aktar("/__kilit_a__.txt", okurken_yaz, &d);
+
+    int32_t ekSatir = fs.satir_hesap("/__kilit_e__.txt");
+    String son = fs.oku("/__kilit_s__.txt");
+    bool tamam = baslayan == 6 && d.hata == 0 && ekSatir == KILIT_TESTI_TUR &&
+                 son == String(KILIT_TESTI_TUR - 1) && fs.satir_hesap("/__kilit_a__.txt") == 10 &&
+                 fs.satir_hesap("/__kilit_g__.txt") == 10;
+    Serial.printf("%u görev, %lu okuma, %lu hata, ekleme %ld satır, sabit '%s', %lu ms: %s\n", baslayan,
+                  (unsigned long)d.okuma, (unsigned long)d.hata, (long)ekSatir, son.c_str(),
+                  (unsigned long)(millis() - bas), tamam ? "TAMAM" : "HATA");
+
+    fs.sabit_birak("/__kilit_s__.txt");
+    fs.gunluk_kapat("/__kilit_g__.txt");
+    fs.sil("/__kilit_a__.txt");
+    fs.sil("/__kilit_g__.txt");
+    fs.sil("/__kilit_e__.txt");
+    fs.sil("/__kilit_s__.txt");
+}
+#endif
+
+#endif
+
 /**
  * @brief Dosya sistemi sınıfı için etkileşimli test konsolu
  * 
@@ -37,6 +808,21 @@ void dosya_sistemi::test()
         Serial.println(F("K - /test.txt dosyasını /kopya.txt olarak kopyala"));
         Serial.println(F("R - /kopya.txt dosyasını /yenisim.txt olarak yeniden adlandır"));
         Serial.println(F("Q - /yenisim.txt dosyasını sil"));
+        Serial.println(F("U - Klasör bazında disk kullanımını göster"));
+        Serial.println(F("T - /test.txt son 2 satırı oku"));
+        Serial.println(F("F - Satır fonksiyonları fark testi (model ve günlüksüz dosya ile karşılaştırma)"));
+        Serial.println(F("M - Satır fonksiyonları hız ölçümü"));
+        Serial.println(F("X - Satır fonksiyonları ölçekleme testi (10^3..10^6 satır)"));
+        Serial.println(F("I - satirlar() yineleyicisi ile String döngüsünü karşılaştır"));
+        Serial.println(F("L - Bloom süzgeçli ve süzgeçsiz ara() karşılaştır"));
+        Serial.println(F("J - Günlüklü ve günlüksüz satır düzenleme hızını karşılaştır"));
+        Serial.println(F("D - /test.txt dosyasını seri porta aktar, ardından aktar() hızını ölç"));
+        Serial.println(F("O - /test.txt dosyasını sırala ve tekrarları at"));
+        Serial.println(F("A - Çok dosyalı ağaçta 'const' ara ve tarama hızını ölç"));
+        Serial.println(F("W - /sayac.txt dosyasını RAM'e sabitle, 1000 kez yaz ve istatistikleri göster"));
+        Serial.println(F("P - Tüm dosya sistemini /yedek.dpa arşivine yaz"));
+        Serial.println(F("C - /yedek.dpa arşivini /geri klasörüne aç"));
+        Serial.println(F("Z - Eşzamanlı görevlerle kilit testi (DEPO_KILITLI)"));
         Serial.println(F("==== Bir komut girin (H yardımı tekrar gösterir) ===="));
         ilk_calistirildi = true;
     }
@@ -145,6 +931,108 @@ void dosya_sistemi::test()
             Serial.println(F("yenisim.txt siliniyor..."));
             sil("/yenisim.txt");
             break;
+
+        case 'U':
+            kullanim_listele("/");
+            break;
+
+        case 'T':
+            Serial.println(F("Son 2 satır:"));
+            Serial.println(son_satirlar("/test.txt", 2));
+            break;
+
+        case 'F':
+        {
+            Serial.println(F("Fark testi çalışıyor..."));
+            uint8_t gecen = 0;
+            for (uint32_t tohum = 1; tohum <= 20; tohum++)
+                gecen += fark_testi(*this, tohum, 100);
+            Serial.printf("Fark testi: %u/20 tohum başarılı\n", gecen);
+            gecen = 0;
+            for (uint32_t tohum = 1; tohum <= 20; tohum++)
+                gecen += gunluk_fark_testi(*this, tohum, 100);
+            Serial.printf("Günlük fark testi: %u/20 tohum başarılı\n", gecen);
+            break;
+        }
+
+        case 'M':
+            hiz_testi(*this);
+            break;
+
+        case 'X':
+            olcekleme_testi(*this);
+            break;
+
+        case 'I':
+            yineleyici_testi(*this);
+            break;
+
+        case 'L':
+            bloom_testi(*this);
+            break;
+
+        case 'J':
+            gunluk_testi(*this);
+            break;
+
+        case 'D':
+            Serial.printf("\n%ld bayt aktarıldı\n", (long)aktar("/test.txt", Serial));
+            aktarma_testi(*this);
+            break;
+
+        case 'A':
+            agac_arama_testi(*this);
+            break;
+
+        case 'W':
+        {
+            sabitle("/sayac.txt", 32);
+            uint32_t bas = millis();
+            for (uint16_t i = 0; i < 1000; i++)
+            {
+                yaz("/sayac.txt", String(i));
+                dongu();
+            }
+            diske_aktar();
+            sabit_istatistik ist = sabit_istatistikleri();
+            Serial.printf("%lu ms, RAM yazma %lu, RAM okuma %lu, flash yazma %lu (%lu bayt; süre %lu, eşik %lu)\n",
+                          (unsigned long)(millis() - bas), (unsigned long)ist.ram_yazma, (unsigned long)ist.ram_okuma,
+                          (unsigned long)ist.aktarma, (unsigned long)ist.aktarilan_bayt, (unsigned long)ist.sureden,
+                          (unsigned long)ist.esikten);
+            Serial.print(F("/sayac.txt: "));
+            Serial.println(oku("/sayac.txt"));
+            sabit_birak("/sayac.txt");
+            break;
+        }
+
+        case 'P':
+        case 'C':
+        {
+            arsiv_rapor rapor;
+            uint32_t bas = millis();
+            bool tamam = komut == 'P' ? arsivle("/", "/yedek.dpa", &rapor) : arsivden_cikar("/yedek.dpa", "/geri", &rapor);
+            Serial.println(tamam ? F("Başarılı") : F("Başarısız"));
+            Serial.printf("%u dosya, %u klasör, %lu bayt, %u atlandı, %u hata, %lu ms\n", rapor.dosya, rapor.dizin,
+                          (unsigned long)rapor.bayt, rapor.atlanan, rapor.hata, (unsigned long)(millis() - bas));
+            break;
+        }
+
+        case 'O':
+        {
+            sirala_rapor rapor;
+            Serial.println(sirala("/test.txt", "/test.txt", nullptr, true, &rapor) ? F("Başarılı") : F("Başarısız"));
+            Serial.printf("%lu satır, %u koşu, %u geçiş, %lu bayt yazıldı\n", (unsigned long)rapor.satir, rapor.kosu,
+                          rapor.gecis, (unsigned long)rapor.yazilan_bayt);
+            break;
+        }
+
+        case 'Z':
+#if DEPO_KILITLI
+            kilit_testi(*this);
+#else
+            Serial.println(F("DEPO_KILITLI kapalı, kilit testi derlenmedi"));
+#endif
+            break;
         }
     }
 #else
@@ -11,7 +11,8 @@
  */
 void dosya_sistemi::sil_full_dizin(const char *dizinYolu)
 {
-    File root = LittleFS.open(dizinYolu, "r");
+    diske_aktar(); // sabit dosyalar dolaşmada görünsün ve silinenler sonradan geri yazılmasın
+    File root = _depo.open(dizinYolu, "r");
     if (!root || !root.isDirectory())
     {
         Serial.print(String(F("Gecersiz dizin: ")) + dizinYolu);
@@ -26,7 +27,7 @@ void dosya_sistemi::sil_full_dizin(const char *dizinYolu)
         {
             Serial.print(String(F("Alt klasor bulundu: ")) + yol);
             sil_full_dizin(yol.c_str());
-            if (LittleFS.rmdir(yol))
+            if (_depo.rmdir(yol))
                 Serial.print(String(F("Klasor silindi: ")) + yol);
             else
                 Serial.print(String(F("Klasor silinemedi: ")) + yol);
@@ -34,8 +35,12 @@ void dosya_sistemi::sil_full_dizin(const char *dizinYolu)
         else
         {
             Serial.print(String(F("Siliniyor: ")) + yol);
-            if (LittleFS.remove(yol))
+            int32_t bayt = dosya.size();
+            if (_depo.remove(yol))
+            {
+                dosya_degisti(yol.c_str(), -bayt);
                 Serial.print(String(F("Dosya silindi: ")) + yol);
+            }
             else
                 Serial.print(String(F("Dosya silinemedi: ")) + yol);
         }
@@ -47,7 +52,7 @@ void dosya_sistemi::sil_full_dizin(const char *dizinYolu)
 
     if (String(dizinYolu) != "/")
     {
-        if (LittleFS.rmdir(dizinYolu))
+        if (_depo.rmdir(dizinYolu))
             Serial.print(String(F("Dizin silindi: ")) + dizinYolu);
         else
             Serial.print(String(F("Dizin silinemedi: ")) + dizinYolu);
@@ -60,76 +65,108 @@ void dosya_sistemi::sil_full_dizin(const char *dizinYolu)
  * @brief Verilen dosyayı siler.
  * 
  * Eğer dosya mevcutsa silinir. Dosya yoksa veya silinemiyorsa hata mesajı yazdırılır.
+ * Dosyanın günlüğü (.jrn) ve Bloom süzgeci (.blm) de silinir, RAM'deki
+ * kayıtları bırakılır; aynı adla sonradan yazılan dosyaya eski günlük
+ * uygulanmaz, eski süzgeç kullanılmaz.
  * 
  * @param dosyaAdi Silinecek dosyanın yolu (örnek: "/log.txt")
  */
 void dosya_sistemi::sil(const char *dosyaAdi)
 {
-    if (LittleFS.exists(dosyaAdi))
+    yol_kilidi kilit(dosyaAdi, true);
+    if (!kilit.tamam())
+        return;
+    sabit_aktar(dosyaAdi);
+    if (_depo.exists(dosyaAdi))
     {
-        if (LittleFS.remove(dosyaAdi))
+        int32_t bayt = sayac_boyut(dosyaAdi);
+        if (_depo.remove(dosyaAdi))
+        {
+            dosya_degisti(dosyaAdi, -bayt);
             Serial.print(String(F("Silindi: ")) + dosyaAdi);
+        }
         else
             Serial.print(String(F("Dosya silinemedi: ")) + dosyaAdi);
     }
     else
         Serial.print(String(F("Dosya yok: ")) + dosyaAdi);
+
+    gunluk_kaydi *g = gunluk_bul(dosyaAdi);
+    if (g)
+    {
+        yol_kilidi::kritik_gir();
+        g->yol = 0;
+        _gunlukAdet--;
+        yol_kilidi::kritik_cik();
+        g->isim = "";
+        g->kayitlar = "";
+        g->kayitSayisi = 0;
+    }
+    bloom_kaydi *b = bloom_bul(dosyaAdi);
+    if (b)
+    {
+        yol_kilidi::kritik_gir();
+        b->yol = 0;
+        _bloomAdet--;
+        yol_kilidi::kritik_cik();
+        b->isim = "";
+    }
+
+    const char *uzantilar[] = {".jrn", ".blm"};
+    for (const char *uzanti : uzantilar)
+    {
+        String yan = String(dosyaAdi) + uzanti;
+        int32_t bayt = sayac_boyut(yan.c_str());
+        if (_depo.exists(yan.c_str()) && _depo.remove(yan.c_str()))
+            dosya_degisti(yan.c_str(), -bayt);
+    }
 }
 
 /**
  * @brief Bir dosyadaki belirli satır aralığını siler.
  * 
- * Dosya okunur, verilen satır aralığı (örnek: 2–4. satırlar) hariç kalan satırlar
- * geçici olarak saklanır. Daha sonra dosya tamamen silinir ve kalan satırlar tekrar yazılır.
+ * Dosya satirlari_yeniden_yaz() ile geçici bir dosyaya akıtılır, verilen satır
+ * aralığı (örnek: 2–4. satırlar) atlanır ve geçici dosya asıl dosyanın yerine
+ * konur. Dosya RAM'e alınmaz; yazma yarıda kalırsa asıl dosya korunur.
  * 
  * @param dosyaAdi Düzenlenecek dosyanın yolu
  * @param ilkSatir Silinmeye başlanacak satır (0'dan başlar)
- * @param sonSatir Silinecek son satır (dahil). 0xFFFF verilirse yalnızca `ilkSatir` silinir.
+ * @param sonSatir Silinecek son satır (dahil). DEPO_SATIR_YOK verilirse yalnızca
+ *                 `ilkSatir` silinir, DEPO_DOSYA_SONU ile dosyanın sonuna kadar silinir.
  */
-void dosya_sistemi::sil(const char *dosyaAdi, uint16_t ilkSatir, uint16_t sonSatir)
+void dosya_sistemi::sil(const char *dosyaAdi, uint32_t ilkSatir, uint32_t sonSatir)
 {
-    int16_t toplamSatir = satir_hesap(dosyaAdi);
-    if (toplamSatir <= 0 || ilkSatir >= toplamSatir)
-    {
-        Serial.print(F("Silme islemi gecersiz."));
+    yol_kilidi kilit(dosyaAdi, true);
+    if (!kilit.tamam())
         return;
-    }
-
-    if (sonSatir == 0xFFFF)
+    sabit_aktar(dosyaAdi);
+    gunluk_isle(dosyaAdi);
+    if (sonSatir == DEPO_SATIR_YOK)
         sonSatir = ilkSatir;
-
-    if (sonSatir >= toplamSatir)
-        sonSatir = toplamSatir - 1;
-
-    File orijinal = LittleFS.open(dosyaAdi, "r");
-    if (!orijinal)
+    if (sonSatir < ilkSatir)
     {
-        Serial.print(F("Dosya acilamadi"));
+        Serial.print(F("Silme islemi gecersiz."));
         return;
     }
 
-    String yeniIcerik = "";
-    uint16_t mevcutSatir = 0;
-
-    while (orijinal.available())
-    {
-        String satir = orijinal.readStringUntil('\n');
-        if (mevcutSatir < ilkSatir || mevcutSatir > sonSatir)
-            yeniIcerik += satir + "\n";
-        mevcutSatir++;
-    }
-    orijinal.close();
-
-    LittleFS.remove(dosyaAdi);
-    File yeniDosya = LittleFS.open(dosyaAdi, "w");
-    if (yeniDosya)
-    {
-        yeniDosya.print(yeniIcerik);
-        yeniDosya.close();
-        Serial.print(F("Satirlar silindi."));
-    }
+    uint32_t silinen = 0;
+    if (!satirlari_yeniden_yaz(dosyaAdi, ilkSatir, sonSatir - ilkSatir + 1, nullptr, &silinen))
+        Serial.print(F("Satirlar silinemedi."));
+    else if (silinen == 0)
+        Serial.print(F("Silme islemi gecersiz."));
     else
-        Serial.print(F("Yeni dosya olusturulamadi."));
+        Serial.print(F("Satirlar silindi."));
+}
+
+/**
+ * @brief Bir dosyadaki satır aralığını siler.
+ *
+ * @param dosyaAdi Düzenlenecek dosyanın yolu
+ * @param aralik Silinecek satırlar (örn. satir_araligi::sona_kadar(100))
+ */
+void dosya_sistemi::sil(const char *dosyaAdi, const satir_araligi &aralik)
+{
+    sil(dosyaAdi, aralik.ilk, aralik.son);
 }
 
 
@@ -140,27 +177,16 @@ void dosya_sistemi::sil(const char *dosyaAdi, uint16_t ilkSatir, uint16_t sonSat
  * @param satirNo Silinecek satır numarası (0 tabanlı)
  * @return true Başarılıysa true, aksi halde false
  */
-bool dosya_sistemi::satir_sil(const char* isim, uint16_t satirNo) {
-    File dosya = LittleFS.open(isim, "r");
-    if (!dosya) return false;
-
-    String yeniIcerik = "";
-    uint16_t sayac = 0;
-    while (dosya.available()) {
-        String satir = "";
-        while (dosya.available()) {
-            char c = dosya.read();
-            if (c == '\n') break;
-            satir += c;
-        }
-        if (sayac != satirNo) {
-            yeniIcerik += satir + "\n";
-        }
-        sayac++;
-    }
-    dosya.close();
-
-    return yaz(isim, yeniIcerik);
+bool dosya_sistemi::satir_sil(const char* isim, uint32_t satirNo) {
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    int8_t gunluk = gunluk_duzenle(isim, GUNLUK_SIL, satirNo, nullptr);
+    if (gunluk >= 0)
+        return gunluk == 1;
+    sabit_aktar(isim);
+    gunluk_isle(isim);
+    return satirlari_yeniden_yaz(isim, satirNo, 1, nullptr);
 }
 
 
@@ -170,6 +196,13 @@ bool dosya_sistemi::satir_sil(const char* isim, uint16_t satirNo) {
  * @param isim Dosya yolu
  */
 void dosya_sistemi::temizle(const char* isim) {
-    File dosya = LittleFS.open(isim, "w");
-    if (dosya) dosya.close();  // İçeriği siler (boş yazar)
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam()) return;
+    if (sabite_yaz(isim, String(), false)) return;
+    int32_t eskiBoyut = sayac_boyut(isim);
+    File dosya = _depo.open(isim, "w");
+    if (dosya) {
+        dosya.close();  // İçeriği siler (boş yazar)
+        dosya_degisti(isim, -eskiBoyut);
+    }
 }
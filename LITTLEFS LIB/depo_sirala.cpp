@@ -0,0 +1,388 @@
+#include "LITTLEFS_LIB.h"
+#include <algorithm>
+
+/**
+ * @brief Bir koşu dosyasının yolunu üretir.
+ */
+static String kosu_yolu(const String &taban, uint8_t gecis, uint16_t no)
+{
+    return taban + "." + String(gecis) + "_" + String(no);
+}
+
+/**
+ * @brief Satırı sonuna '\n' ekleyerek yazar.
+ *
+ * @param yazilan Yazılan bayt sayısı buna eklenir
+ * @return true Satırın tamamı yazıldıysa
+ */
+static bool satir_yaz(File &cikti, const char *satir, uint32_t &yazilan)
+{
+    size_t n = strlen(satir);
+    size_t yazildi = cikti.write((const uint8_t *)satir, n);
+    yazildi += cikti.write((uint8_t)'\n');
+    yazilan += yazildi;
+    return yazildi == n + 1;
+}
+
+/**
+ * @brief Satır işaretçilerini sıralar ve sırayla dosyaya yazar.
+ *
+ * @param yazilan Yazılan bayt sayısı buna eklenir
+ * @return true Tüm satırlar yazıldıysa, false yazma yarıda kaldıysa (örn. disk dolu)
+ */
+static bool satirlari_yaz(File &cikti, char **satirlar, uint16_t adet, satir_karsilastir karsilastir, bool tekil,
+                          uint32_t &yazilan)
+{
+    std::sort(satirlar, satirlar + adet, [karsilastir](const char *a, const char *b)
+              { return karsilastir(a, b) < 0; });
+
+    const char *onceki = nullptr;
+    for (uint16_t i = 0; i < adet; i++)
+    {
+        if (tekil && onceki && karsilastir(onceki, satirlar[i]) == 0)
+            continue;
+        if (!satir_yaz(cikti, satirlar[i], yazilan))
+            return false;
+        onceki = satirlar[i];
+    }
+    return true;
+}
+
+/**
+ * @brief Koşu dosyasının sıradaki satırını kendi bölgesinden verir.
+ *
+ * Bölge koşudan blok blok doldurulur ve satır sonu yerinde '\0' yapılır.
+ * Satır bölgenin sonunda yarım kalırsa kalan kısım başa kaydırılıp bölge
+ * yeniden doldurulur; bölge koşudaki en uzun satırdan büyük olmalıdır.
+ *
+ * @return const char* Satır (bir sonraki çağrıya kadar geçerli), koşu bittiyse nullptr
+ */
+static const char *kosu_satiri(File &kosu, char *bolge, size_t boyut, size_t &dolu, size_t &konum)
+{
+    for (;;)
+    {
+        char *sonu = (char *)memchr(bolge + konum, '\n', dolu - konum);
+        if (sonu)
+        {
+            *sonu = '\0';
+            const char *satir = bolge + konum;
+            konum = sonu - bolge + 1;
+            return satir;
+        }
+
+        memmove(bolge, bolge + konum, dolu - konum);
+        dolu -= konum;
+        konum = 0;
+        size_t n = kosu && dolu < boyut ? kosu.read((uint8_t *)bolge + dolu, boyut - dolu) : 0;
+        if (n == 0)
+        {
+            // '\n' ile bitmeyen son satır
+            if (dolu == 0 || dolu >= boyut)
+                return nullptr;
+            bolge[dolu] = '\0';
+            konum = dolu;
+            return bolge;
+        }
+        dolu += n;
+    }
+}
+
+/**
+ * @brief `adet` sıralı koşuyu tek bir sıralı dosyada birleştirir.
+ *
+ * Her koşuya `bolge` baytlık bir okuma bölgesi ayrılır; satırlar bu bölgelerde
+ * yerinde karşılaştırılır, satır başına String oluşturulmaz. `tekil` ise son
+ * yazılan satır da aynı boyda ayrı bir bölgede tutulur. Okunan koşu
+ * dosyaları yalnızca çıktı eksiksiz yazıldıysa silinir; aksi halde yarım
+ * çıktı silinir ve koşular yerinde kalır.
+ *
+ * @return true Birleştirme eksiksiz yazıldıysa
+ */
+static bool kosulari_birlestir(fs::FS &depo, const String &taban, uint8_t gecis, uint16_t ilk, uint16_t adet, const char *cikisYolu,
+                               satir_karsilastir karsilastir, bool tekil, size_t bolge, uint32_t &yazilan)
+{
+    // Son bölge tekil birleştirmede son yazılan satırı tutar
+    char *tampon = (char *)malloc(bolge * (tekil ? adet + 1 : adet));
+    if (!tampon)
+        return false;
+    char *son = tampon + bolge * adet;
+
+    File cikti = depo.open(cikisYolu, "w");
+    if (!cikti)
+    {
+        free(tampon);
+        return false;
+    }
+
+    File girdiler[DEPO_SIRALA_KOL];
+    const char *satirlar[DEPO_SIRALA_KOL];
+    size_t dolu[DEPO_SIRALA_KOL];
+    size_t konum[DEPO_SIRALA_KOL];
+    bool tamam = true;
+    for (uint16_t i = 0; i < adet; i++)
+    {
+        girdiler[i] = depo.open(kosu_yolu(taban, gecis, ilk + i).c_str(), "r");
+        if (!girdiler[i])
+            tamam = false; // açılamayan koşunun satırları sessizce kaybolmamalı
+        dolu[i] = konum[i] = 0;
+        satirlar[i] = kosu_satiri(girdiler[i], tampon + i * bolge, bolge, dolu[i], konum[i]);
+    }
+
+    bool ilkSatir = true;
+    while (tamam)
+    {
+        int16_t enKucuk = -1;
+        for (uint16_t i = 0; i < adet; i++)
+        {
+            if (satirlar[i] && (enKucuk < 0 || karsilastir(satirlar[i], satirlar[enKucuk]) < 0))
+                enKucuk = i;
+        }
+        if (enKucuk < 0)
+            break;
+
+        const char *satir = satirlar[enKucuk];
+        if (!tekil || ilkSatir || karsilastir(son, satir) != 0)
+        {
+            if (!satir_yaz(cikti, satir, yazilan))
+            {
+                tamam = false;
+                break;
+            }
+            if (tekil)
+                strcpy(son, satir); // bölge en uzun satırı ve sonlandırıcısını alır
+            ilkSatir = false;
+        }
+        satirlar[enKucuk] = kosu_satiri(girdiler[enKucuk], tampon + enKucuk * bolge, bolge, dolu[enKucuk], konum[enKucuk]);
+    }
+
+    cikti.close();
+    for (uint16_t i = 0; i < adet; i++)
+    {
+        if (girdiler[i])
+            girdiler[i].close();
+        if (tamam)
+            depo.remove(kosu_yolu(taban, gecis, ilk + i).c_str());
+    }
+    if (!tamam)
+        depo.remove(cikisYolu);
+    free(tampon);
+    return tamam;
+}
+
+/**
+ * @brief Koşu üretiminin sirala() ile kosu_besle() arasında paylaşılan durumu.
+ */
+struct kosu_uretimi
+{
+    fs::FS *depo;
+    const String *taban;
+    char *tampon;
+    char **isaretciSonu;
+    size_t dolu;
+    size_t bas;
+    uint16_t adet;
+    size_t enUzun;
+    satir_karsilastir karsilastir;
+    bool tekil;
+    sirala_rapor *r;
+    bool tamam;
+};
+
+/**
+ * @brief Tampondaki tam satırları sıralı bir koşu dosyasına yazar, yarım satırı başa taşır.
+ */
+static bool kosu_yaz(kosu_uretimi &k)
+{
+    if (k.adet == 0)
+    {
+        Serial.print(F("Satir siralama tamponuna sigmiyor"));
+        return false;
+    }
+    File kosu = k.depo->open(kosu_yolu(*k.taban, 0, k.r->kosu).c_str(), "w");
+    if (!kosu)
+        return false;
+    bool yazildi = satirlari_yaz(kosu, k.isaretciSonu - k.adet, k.adet, k.karsilastir, k.tekil, k.r->yazilan_bayt);
+    kosu.close();
+    k.r->kosu++; // yarım kalsa da sayılır, hata temizliği onu da siler
+    if (!yazildi)
+        return false;
+
+    memmove(k.tampon, k.tampon + k.bas, k.dolu - k.bas);
+    k.dolu -= k.bas;
+    k.bas = 0;
+    k.adet = 0;
+    return true;
+}
+
+/**
+ * @brief Tampon sonundaki satırı sonlandırır ve işaretçisini kaydeder.
+ */
+static void satiri_bitir(kosu_uretimi &k)
+{
+    k.tampon[k.dolu++] = '\0';
+    k.isaretciSonu[-(int)(k.adet + 1)] = k.tampon + k.bas;
+    k.adet++;
+    k.r->satir++;
+    if (k.dolu - k.bas - 1 > k.enUzun)
+        k.enUzun = k.dolu - k.bas - 1;
+    k.bas = k.dolu;
+}
+
+/**
+ * @brief aktar() parçalarını sıralama tamponuna ekler; satırları yerinde ayırır.
+ *
+ * Parça satır sonlarına göre bölünüp tampona kopyalanır. Yeni bölüm için yer
+ * kalmadıysa tamponun tam satırları önce bir koşu olarak yazılır.
+ */
+static bool kosu_besle(const uint8_t *parca, size_t uzunluk, void *veri)
+{
+    kosu_uretimi &k = *(kosu_uretimi *)veri;
+    while (uzunluk > 0)
+    {
+        const uint8_t *satirSonu = (const uint8_t *)memchr(parca, '\n', uzunluk);
+        size_t n = satirSonu ? satirSonu - parca : uzunluk;
+
+        // Bölümün kendisi, sonlandırıcısı ve bu satırın işaretçisi için yer kalmalı
+        if (k.dolu + n + 1 + (k.adet + 1) * sizeof(char *) > DEPO_SIRALA_TAMPON)
+        {
+            if (!kosu_yaz(k))
+            {
+                k.tamam = false;
+                return false;
+            }
+            if (k.dolu + n + 1 + sizeof(char *) > DEPO_SIRALA_TAMPON)
+            {
+                Serial.print(F("Satir siralama tamponuna sigmiyor"));
+                k.tamam = false;
+                return false;
+            }
+        }
+        memcpy(k.tampon + k.dolu, parca, n);
+        k.dolu += n;
+        if (satirSonu)
+        {
+            satiri_bitir(k);
+            n++;
+        }
+        parca += n;
+        uzunluk -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Satır dosyasını sabit RAM ile sıralar (harici birleştirmeli sıralama).
+ *
+ * Kaynak dosya bloklar halinde okunup DEPO_SIRALA_TAMPON baytlık tek bir tampona
+ * sığdığı kadar satırlarına yerinde ayrılır, bellekte sıralanır ve geçici bir
+ * "koşu" dosyasına yazılır. Ardından koşular DEPO_SIRALA_KOL'luk gruplar halinde
+ * birleştirilir; her koşu kendi okuma bölgesinden blok blok okunur. Koşu sayısı
+ * bire inene kadar geçişler tekrarlanır. Böylece boş heap'ten kat kat büyük
+ * dosyalar sıralanabilir. Tampona sığmayan tek bir satır varsa sıralama yapılmaz.
+ *
+ * Sonuç önce geçici bir dosyaya yazılır ve yalnızca eksiksiz yazıldıysa
+ * `hedef`in yerine konur; yazma yarıda kalırsa (örn. disk dolu) `hedef`e
+ * dokunulmaz. Bu yüzden `kaynak` ile `hedef` aynı dosya olabilir.
+ *
+ * @param kaynak Sıralanacak dosya
+ * @param hedef Sonucun yazılacağı dosya
+ * @param karsilastir Satır karşılaştırma fonksiyonu (strcmp gibi), nullptr ise strcmp
+ * @param tekil true ise eşit satırlardan yalnızca biri yazılır
+ * @param rapor Geçiş sayısı ve yazılan bayt gibi istatistikler (isteğe bağlı)
+ * @return true Sıralama tamamlandıysa
+ */
+bool dosya_sistemi::sirala(const char *kaynak, const char *hedef, satir_karsilastir karsilastir, bool tekil,
+                           sirala_rapor *rapor)
+{
+    yol_kilidi kilit(kaynak, hedef);
+    if (!kilit.tamam())
+        return false;
+    if (!karsilastir)
+        karsilastir = strcmp;
+
+    // Satırlar tamponun başından, satır işaretçileri sonundan doğru büyür
+    char *tampon = (char *)malloc(DEPO_SIRALA_TAMPON);
+    if (!tampon)
+        return false;
+
+    sirala_rapor r;
+    uint32_t eskiBoyut = sayac_boyut(hedef);
+    String taban = gecici_isim();
+    String sonuc = taban + ".son"; // hedefin yerine konmadan önce sonuç buraya yazılır
+    kosu_uretimi k = {&_depo, &taban, tampon, (char **)(tampon + DEPO_SIRALA_TAMPON), 0, 0, 0, 0,
+                      karsilastir, tekil, &r, true};
+
+    // Kaynak aktar() ile DEPO_AKTAR_TAMPON'luk bloklar halinde okunur
+    bool tamam = aktar(kaynak, kosu_besle, &k) >= 0 && k.tamam;
+    if (tamam && k.dolu > k.bas)
+    {
+        // '\n' ile bitmeyen son satır
+        if (k.dolu + 1 + (k.adet + 1) * sizeof(char *) > DEPO_SIRALA_TAMPON && !kosu_yaz(k))
+            tamam = false;
+        else
+            satiri_bitir(k);
+    }
+    uint16_t adet = k.adet;
+    char **isaretciSonu = k.isaretciSonu;
+
+    if (tamam && (adet > 0 || r.kosu == 0))
+    {
+        // Hiç koşu yazılmadıysa tüm dosya tampona sığmıştır: doğrudan sonuca yazılır
+        String yol = r.kosu == 0 ? sonuc : kosu_yolu(taban, 0, r.kosu);
+        File cikti = _depo.open(yol.c_str(), "w");
+        if (cikti)
+        {
+            tamam = satirlari_yaz(cikti, isaretciSonu - adet, adet, karsilastir, tekil, r.yazilan_bayt);
+            cikti.close();
+            r.kosu++;
+        }
+        else
+            tamam = false;
+    }
+    free(tampon);
+    r.gecis = 1;
+
+    // Her koşunun okuma bölgesi en uzun satırı ve sonundaki '\n'i alabilmeli
+    size_t bolge = DEPO_SIRALA_TAMPON / DEPO_SIRALA_KOL;
+    if (bolge < k.enUzun + 2)
+        bolge = k.enUzun + 2;
+
+    uint16_t kosuSayisi = r.kosu;
+    uint8_t gecis = 0;
+    while (tamam && kosuSayisi > 1)
+    {
+        bool sonGecis = kosuSayisi <= DEPO_SIRALA_KOL;
+        uint16_t yeniSayi = 0;
+        for (uint16_t ilk = 0; ilk < kosuSayisi && tamam; ilk += DEPO_SIRALA_KOL)
+        {
+            uint16_t n = kosuSayisi - ilk < DEPO_SIRALA_KOL ? kosuSayisi - ilk : DEPO_SIRALA_KOL;
+            String cikis = sonGecis ? sonuc : kosu_yolu(taban, gecis + 1, yeniSayi);
+            tamam = kosulari_birlestir(_depo, taban, gecis, ilk, n, cikis.c_str(), karsilastir, tekil, bolge, r.yazilan_bayt);
+            yeniSayi++;
+        }
+        if (!tamam)
+            break; // temizlik yarım kalan bu geçişin koşularına bakar
+        kosuSayisi = yeniSayi;
+        gecis++;
+        r.gecis++;
+    }
+
+    if (tamam && !yerine_koy(sonuc.c_str(), hedef))
+        tamam = false;
+    else if (tamam)
+        dosya_degisti(hedef, (int32_t)sayac_boyut(hedef) - (int32_t)eskiBoyut);
+    else
+    {
+        // Yarım kalan geçişin koşularını ve sonucunu temizle; hedefe dokunulmadı
+        for (uint16_t i = 0; i < r.kosu; i++)
+        {
+            _depo.remove(kosu_yolu(taban, gecis, i).c_str());
+            _depo.remove(kosu_yolu(taban, gecis + 1, i).c_str());
+        }
+        _depo.remove(sonuc.c_str());
+    }
+
+    if (rapor)
+        *rapor = r;
+    return tamam;
+}
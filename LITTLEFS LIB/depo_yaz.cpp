@@ -3,8 +3,10 @@
 /**
  * @brief Belirli bir satırı yeni içerikle değiştirir.
  *
- * Dosya geçici olarak başka bir dosyaya kopyalanır ve
- * sadece hedef satır değiştirilerek tekrar kaydedilir.
+ * Yeni içerik eski satırla aynı uzunluktaysa (örn. sabit genişlikli sayaç)
+ * yalnızca o bölge yama() ile yerinde üzerine yazılır. Aksi halde dosya
+ * satirlari_yeniden_yaz() ile geçici bir dosyaya akıtılır ve sadece hedef
+ * satır değiştirilerek tekrar kaydedilir. Satır yoksa dosyaya dokunulmaz.
  *
  * @param isim Değiştirilecek dosyanın adı
  * @param satirNo Değiştirilecek satır numarası (0 tabanlı)
@@ -12,44 +14,117 @@
  * @return true Başarıyla değiştirildiyse
  * @return false Hata oluştuysa
  */
-bool dosya_sistemi::satir_degistir(const char *isim, uint16_t satirNo, const String &yeniIcerik)
+bool dosya_sistemi::satir_degistir(const char *isim, uint32_t satirNo, const String &yeniIcerik)
 {
-    if (!LittleFS.exists(isim))
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    int8_t gunluk = gunluk_duzenle(isim, GUNLUK_DEGISTIR, satirNo, &yeniIcerik);
+    if (gunluk >= 0)
+        return gunluk == 1;
+    sabit_aktar(isim);
+    gunluk_isle(isim);
+    if (!_depo.exists(isim))
         return false;
 
-    File eski = LittleFS.open(isim, "r");
-    if (!eski || eski.isDirectory())
+    uint32_t satirBasi, satirUzunlugu;
+    if (!satir_konumu(isim, satirNo, satirBasi, satirUzunlugu))
+        return true; // böyle bir satır yok
+    if (satirUzunlugu == yeniIcerik.length())
+        return yama(isim, satirBasi, yeniIcerik);
+    return satirlari_yeniden_yaz(isim, satirNo, 1, &yeniIcerik);
+}
+
+
+/**
+ * @brief Dosyanın bir bölümünü, boyutunu değiştirmeden yerinde üzerine yazar.
+ *
+ * Dosya "r+" modunda açılıp `konum`a gidilir ve yalnızca `uzunluk` bayt yazılır.
+ * Geçici dosya, silme ve yeniden adlandırma yapılmaz; LittleFS yalnızca
+ * değişen bloktan itibaren yazar. Bölge dosyanın dışına taşarsa yazılmaz.
+ * Önbellekler (özet, sabit kopya, süzgeç) yalnızca dosyaya bayt yazıldıysa
+ * geçersiz sayılır.
+ *
+ * @param isim Dosya yolu
+ * @param konum Yazmaya başlanacak bayt konumu
+ * @param veri Yazılacak veri
+ * @param uzunluk Veri uzunluğu (bayt)
+ * @return true Başarılıysa true, aksi halde false
+ */
+bool dosya_sistemi::yama(const char *isim, uint32_t konum, const uint8_t *veri, size_t uzunluk)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    sabit_aktar(isim);
+    gunluk_isle(isim);
+    File dosya = _depo.open(isim, "r+");
+    if (!dosya || dosya.isDirectory())
         return false;
 
-    const char *geciciIsim = "/__gecici__.tmp";
-    File yeni = LittleFS.open(geciciIsim, "w");
-    if (!yeni)
-    {
-        eski.close();
+    bool tamam = konum + uzunluk <= dosya.size() && dosya.seek(konum, SeekSet);
+    size_t yazilan = tamam ? dosya.write(veri, uzunluk) : 0;
+    dosya.close();
+    if (yazilan > 0)
+        dosya_degisti(isim, 0); // yarım kalan yazma da içeriği değiştirmiştir
+    return tamam && yazilan == uzunluk;
+}
+
+/** String versiyonu */
+bool dosya_sistemi::yama(const char *isim, uint32_t konum, const String &veri)
+{
+    return yama(isim, konum, (const uint8_t *)veri.c_str(), veri.length());
+}
+
+/**
+ * @brief Bir satırın dosyadaki bayt konumunu ve uzunluğunu bulur.
+ *
+ * Dosya DEPO_TAMPON boyutlu bloklarla taranır, satır için String oluşturulmaz.
+ *
+ * @param isim Dosya yolu
+ * @param satirNo Aranan satır (0 tabanlı)
+ * @param bas Satırın ilk baytının konumu
+ * @param uzunluk Satırın satır sonu hariç uzunluğu
+ * @return true Satır varsa, false dosya açılamazsa veya satır yoksa
+ */
+bool dosya_sistemi::satir_konumu(const char *isim, uint32_t satirNo, uint32_t &bas, uint32_t &uzunluk)
+{
+    File dosya = _depo.open(isim, "r");
+    if (!dosya || dosya.isDirectory())
         return false;
-    }
 
-    String satir;
-    uint16_t sayac = 0;
-    while (satirOku(eski, satir))
+    uint8_t tampon[DEPO_TAMPON];
+    uint32_t sayac = 0;
+    uint32_t konum = 0;
+    bool basBulundu = satirNo == 0;
+    bas = 0;
+    while (dosya.available())
     {
-        if (sayac == satirNo)
-            yeni.println(yeniIcerik);
-        else
-            yeni.println(satir);
-        sayac++;
+        size_t n = dosya.read(tampon, sizeof(tampon));
+        if (n == 0)
+            break;
+        for (size_t i = 0; i < n; i++, konum++)
+        {
+            if (tampon[i] != '\n')
+                continue;
+            if (basBulundu)
+            {
+                uzunluk = konum - bas;
+                dosya.close();
+                return true;
+            }
+            if (++sayac == satirNo)
+            {
+                bas = konum + 1;
+                basBulundu = true;
+            }
+        }
     }
-
-    eski.close();
-    yeni.close();
-
-    // Eski dosyayı sil, geçiciyi yeni adla yeniden adlandır
-    LittleFS.remove(isim);
-    LittleFS.rename(geciciIsim, isim);
-    return true;
+    dosya.close();
+    uzunluk = konum - bas;
+    return basBulundu && bas < konum; // son satır: sonunda '\n' yok
 }
 
-
 /**
  * @brief Belirli bir satıra satır ekler (var olanlar kaydırılır).
  * 
@@ -58,32 +133,127 @@ bool dosya_sistemi::satir_degistir(const char *isim, uint16_t satirNo, const Str
  * @param veri Eklenecek satır içeriği
  * @return true Başarılıysa true, aksi halde false
  */
-bool dosya_sistemi::satir_ekle(const char* isim, uint16_t konum, const String& veri) {
-    File dosya = LittleFS.open(isim, "r");
-    if (!dosya) return false;
+bool dosya_sistemi::satir_ekle(const char* isim, uint32_t konum, const String& veri) {
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam()) return false;
+    int8_t gunluk = gunluk_duzenle(isim, GUNLUK_EKLE, konum, &veri);
+    if (gunluk >= 0)
+        return gunluk == 1;
+    sabit_aktar(isim);
+    gunluk_isle(isim);
+    // Eğer konum son satırdan büyükse, sona eklenir
+    return satirlari_yeniden_yaz(isim, konum, 0, &veri);
+}
 
-    String yeniIcerik = "";
-    uint16_t sayac = 0;
-    while (dosya.available()) {
-        String satir = "";
-        while (dosya.available()) {
-            char c = dosya.read();
-            if (c == '\n') break;
-            satir += c;
-        }
-        if (sayac == konum) {
-            yeniIcerik += veri + "\n";
+/**
+ * @brief Dosyayı satır satır geçici bir dosyaya akıtarak yeniden yazar.
+ *
+ * `ilk` satırdan başlayan `silinecek` satır atlanır, `eklenecek` verilmişse
+ * `ilk` satırın yerine (dosya daha kısaysa sona) yeni bir satır olarak yazılır.
+ * Veri DEPO_TAMPON boyutlu giriş/çıkış tamponlarıyla taşınır; dosya boyutu
+ * ne olursa olsun RAM kullanımı sabittir. Her satır '\n' ile biter. Hiçbir
+ * satır silinmeyecek ve eklenmeyecekse dosyaya dokunulmaz. Yazma yarıda
+ * kalırsa (örn. disk dolu) asıl dosya korunur ve geçici dosya silinir.
+ * Geçici dosya asıl dosyanın yerine yerine_koy() ile konur.
+ *
+ * @param isim Dosya yolu
+ * @param ilk Silme/eklemenin yapılacağı satır (0 tabanlı)
+ * @param silinecek Atlanacak satır sayısı
+ * @param eklenecek Eklenecek satır (satır sonu olmadan), yoksa nullptr
+ * @param silinen Gerçekte atlanan satır sayısı (isteğe bağlı)
+ * @return true Başarılıysa (değişiklik olmasa bile), false dosya açılamaz veya yazılamazsa
+ */
+bool dosya_sistemi::satirlari_yeniden_yaz(const char *isim, uint32_t ilk, uint32_t silinecek,
+                                          const String *eklenecek, uint32_t *silinen)
+{
+    if (silinen)
+        *silinen = 0;
+    File eski = _depo.open(isim, "r");
+    if (!eski || eski.isDirectory())
+        return false;
+
+    String geciciIsim = gecici_isim();
+    File yeni = _depo.open(geciciIsim.c_str(), "w");
+    if (!yeni)
+    {
+        eski.close();
+        return false;
+    }
+    int32_t eskiBoyut = eski.size();
+
+    uint8_t giris[DEPO_TAMPON];
+    uint8_t cikis[DEPO_TAMPON];
+    size_t dolu = 0;
+    uint32_t satir = 0;
+    uint32_t atlanan = 0;
+    bool satirBasi = true;
+    bool atla = false;
+    bool eklendi = eklenecek == nullptr;
+    bool tamam = true;
+
+    while (tamam && eski.available())
+    {
+        size_t n = eski.read(giris, sizeof(giris));
+        if (n == 0)
+            break;
+        for (size_t i = 0; i < n; i++)
+        {
+            if (satirBasi)
+            {
+                if (!eklendi && satir == ilk)
+                {
+                    tamam &= yeni.write(cikis, dolu) == dolu;
+                    dolu = 0;
+                    tamam &= yeni.print(*eklenecek) == eklenecek->length();
+                    tamam &= yeni.print('\n') == 1;
+                    eklendi = true;
+                }
+                atla = satir >= ilk && satir - ilk < silinecek;
+                if (atla)
+                    atlanan++;
+                satirBasi = false;
+            }
+            if (!atla)
+            {
+                cikis[dolu++] = giris[i];
+                if (dolu == sizeof(cikis))
+                {
+                    tamam &= yeni.write(cikis, dolu) == dolu;
+                    dolu = 0;
+                }
+            }
+            if (giris[i] == '\n')
+            {
+                satir++;
+                satirBasi = true;
+            }
         }
-        yeniIcerik += satir + "\n";
-        sayac++;
     }
-    // Eğer konum son satırdan büyükse, sona ekle
-    if (konum >= sayac) {
-        yeniIcerik += veri + "\n";
+    if (!satirBasi && !atla)
+        cikis[dolu++] = '\n'; // sonunda satır sonu olmayan son satır
+    tamam &= yeni.write(cikis, dolu) == dolu;
+    if (!eklendi)
+    {
+        tamam &= yeni.print(*eklenecek) == eklenecek->length();
+        tamam &= yeni.print('\n') == 1;
     }
-    dosya.close();
 
-    return yaz(isim, yeniIcerik);
+    int32_t yeniBoyut = yeni.size();
+    eski.close();
+    yeni.close();
+
+    if (!tamam || (eklenecek == nullptr && atlanan == 0))
+    {
+        _depo.remove(geciciIsim.c_str());
+        return tamam;
+    }
+
+    if (!yerine_koy(geciciIsim.c_str(), isim))
+        return false;
+    dosya_degisti(isim, yeniBoyut - eskiBoyut);
+    if (silinen)
+        *silinen = atlanan;
+    return true;
 }
 
 
@@ -92,16 +262,29 @@ bool dosya_sistemi::satir_ekle(const char* isim, uint16_t konum, const String& v
 
 /**
  * @brief Dosyanın içeriğini tamamen yazar (varsa eski içerik silinir).
+ *
+ * Flash'taki içerik `veri` ile aynıysa hiçbir şey yazılmaz (bkz. icerik_ayni).
+ * Dosya sabitle() ile RAM'e sabitlenmişse yalnızca RAM kopyası değişir.
+ * İçerik özeti yalnızca `veri`nin tamamı yazıldıysa kaydedilir.
  * 
  * @param isim Dosya yolu
  * @param veri Yazılacak metin
- * @return true Başarılıysa true, aksi halde false
+ * @return true Başarılıysa true, aksi halde false (örn. disk doldu)
  */
 bool dosya_sistemi::yaz(const char* isim, const String& veri) {
-    File dosya = LittleFS.open(isim, "w");
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam()) return false;
+    if (sabite_yaz(isim, veri, false)) return true; // RAM'e sabit dosya
+    uint32_t crc;
+    if (icerik_ayni(isim, veri, crc)) return true; // flash'taki içerik zaten aynı
+    uint32_t eskiBoyut = sayac_boyut(isim);
+    File dosya = _depo.open(isim, "w");
     if (!dosya) return false;
-    dosya.print(veri);
+    size_t yazilan = dosya.print(veri);
     dosya.close();
+    dosya_degisti(isim, (int32_t)yazilan - (int32_t)eskiBoyut); // eski özeti de siler
+    if (yazilan != veri.length()) return false;
+    ozet_kaydet(isim, veri.length(), crc);
     return true;
 }
 
@@ -121,65 +304,94 @@ bool dosya_sistemi::yaz(const char* isim, float veri) {
  * @brief Dosyanın içeriğini tamamen silip, yeni içerik ile değiştirir.
  *
  * Verilen dosya yazma modunda açılır, eski içerik silinir ve `yeniIcerik` yazılır.
+ * Flash'taki içerik zaten `yeniIcerik` ise dosyaya dokunulmaz.
  *
  * @param isim Değiştirilecek dosyanın adı (örnek: "/ayar.txt")
  * @param yeniIcerik Dosyaya yazılacak yeni içerik (String olarak)
  */
 void dosya_sistemi::degistir(const char *isim, const String &yeniIcerik)
 {
-    File dosya = LittleFS.open(isim, "w"); // 'w' = write, eski içerik silinir
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return;
+    if (sabite_yaz(isim, yeniIcerik, false))
+    {
+        Serial.println(F("icerik basariyla değistirildi"));
+        return;
+    }
+    uint32_t crc;
+    if (icerik_ayni(isim, yeniIcerik, crc))
+    {
+        Serial.println(F("icerik ayni, yazilmadi"));
+        return;
+    }
+    uint32_t eskiBoyut = sayac_boyut(isim);
+    File dosya = _depo.open(isim, "w"); // 'w' = write, eski içerik silinir
     if (!dosya)
     {
         Serial.println(F("Dosya acilamadi"));
         return;
     }
 
-    dosya.print(yeniIcerik); // Yeni içerik dosyaya yazılır
+    size_t yazilan = dosya.print(yeniIcerik); // Yeni içerik dosyaya yazılır
     dosya.close();
+    dosya_degisti(isim, (int32_t)yazilan - (int32_t)eskiBoyut); // eski özeti de siler
+    if (yazilan != yeniIcerik.length())
+    {
+        Serial.println(F("icerik yazilamadi"));
+        return;
+    }
+    ozet_kaydet(isim, yeniIcerik.length(), crc);
     Serial.println(F("icerik basariyla değistirildi"));
 }
 
 // Dosyayı başka bir isimle yeniden adlandırır
 bool dosya_sistemi::yeniden_adlandir(const char *eskiIsim, const char *yeniIsim)
 {
-    if (!LittleFS.exists(eskiIsim))
+    yol_kilidi kilit(eskiIsim, yeniIsim, true);
+    if (!kilit.tamam())
         return false;
-    if (LittleFS.exists(yeniIsim))
+    sabit_aktar(eskiIsim);
+    gunluk_isle(eskiIsim); // günlük eski isme bağlı
+    if (!_depo.exists(eskiIsim))
+        return false;
+    if (_depo.exists(yeniIsim))
         return false; // hedef dosya varsa işlem yapma
-    return LittleFS.rename(eskiIsim, yeniIsim);
+    if (!_depo.rename(eskiIsim, yeniIsim))
+        return false;
+    dosya_degisti(eskiIsim, 0);
+    dosya_degisti(yeniIsim, 0);
+    return true;
 }
 
-// Dosya kopyalama (basit, küçük dosyalar için)
+// Dosya kopyalama; içerik aktar() ile taşındığı için sabit ve günlüklü kaynak güncel haliyle kopyalanır
 bool dosya_sistemi::kopyala(const char *kaynak, const char *hedef)
 {
-    File src = LittleFS.open(kaynak, "r");
-    if (!src)
+    yol_kilidi kilit(kaynak, hedef);
+    if (!kilit.tamam())
+        return false;
+    if (boyut(kaynak) < 0)
         return false;
-    File dst = LittleFS.open(hedef, "w");
+    uint32_t eskiBoyut = sayac_boyut(hedef);
+    File dst = _depo.open(hedef, "w");
     if (!dst)
-    {
-        src.close();
         return false;
-    }
-    while (src.available())
-    {
-        dst.write(src.read());
-    }
-    src.close();
+    int32_t yeniBoyut = aktar(kaynak, dst);
     dst.close();
-    return true;
+    dosya_degisti(hedef, (int32_t)sayac_boyut(hedef) - (int32_t)eskiBoyut);
+    return yeniBoyut >= 0;
 }
 
 // Dizin oluşturur
 bool dosya_sistemi::dizin_olustur(const char *yol)
 {
-    return LittleFS.mkdir(yol);
+    return _depo.mkdir(yol);
 }
 
 // Dizin boş mu kontrol eder (dosya varsa false döner)
 bool dosya_sistemi::bos_mu(const char *yol)
 {
-    File dir = LittleFS.open(yol, "r");
+    File dir = _depo.open(yol, "r");
     if (!dir || !dir.isDirectory())
         return false;
     File f = dir.openNextFile();
@@ -235,14 +447,27 @@ void dosya_sistemi::degistir(const char *isim, float yeniIcerik)
  */
 void dosya_sistemi::ekle(const char *isim, const String &yeniIcerik)
 {
-    File dosya = LittleFS.open(isim, "a"); // 'a' = append (ekleme)
-    if (!dosya)
-    {
-        Serial.println(F("Dosya acilamadi"));
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
         return;
+    gunluk_isle(isim); // eklenen içerik günlük uygulanmış halin sonuna gelmeli
+    bloom_kaydi *b = bloom_bul(isim);
+    bool bloomGuncel = b && !b->eski;
+    if (!sabite_yaz(isim, yeniIcerik, true))
+    {
+        File dosya = _depo.open(isim, "a"); // 'a' = append (ekleme)
+        if (!dosya)
+        {
+            Serial.println(F("Dosya acilamadi"));
+            return;
+        }
+        size_t yazilan = dosya.print(yeniIcerik); // Yeni satır olarak ekle
+        dosya.close();
+        dosya_degisti(isim, yazilan);
     }
-    dosya.print(yeniIcerik); // Yeni satır olarak ekle
-    dosya.close();
+    // Süzgeç yeniden kurulmak yerine eklenen satırlarla güncellenir
+    if (bloomGuncel)
+        bloom_ekle(*b, yeniIcerik);
     Serial.println(F("icerik basariyla eklendi"));
 }
 
@@ -278,3 +503,225 @@ void dosya_sistemi::ekle(const char *isim, float yeniIcerik)
 {
     ekle(isim, String(yeniIcerik));
 }
+
+/**
+ * @brief Ham bayt dizisini (yaz_yapi) dosyaya yazar.
+ *
+ * `surum` 0 değilse verinin önüne imza, sürüm, boyut ve CRC içeren
+ * bir depo_yapi_basligi yazılır. Heap kullanılmaz, veri tek seferde yazılır.
+ *
+ * @param isim Dosya yolu
+ * @param veri Yazılacak veri
+ * @param uzunluk Veri uzunluğu (bayt)
+ * @param surum Şema sürümü, 0 ise başlık yazılmaz
+ * @return true Başarılıysa true, aksi halde false
+ */
+bool dosya_sistemi::yapi_yaz(const char *isim, const void *veri, size_t uzunluk, uint16_t surum)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    sabit_aktar(isim);
+    uint32_t eskiBoyut = sayac_boyut(isim);
+    File dosya = _depo.open(isim, "w");
+    if (!dosya)
+        return false;
+
+    size_t yazilan = 0;
+    if (surum != 0)
+    {
+        depo_yapi_basligi baslik = {DEPO_YAPI_IMZA, surum, (uint16_t)uzunluk, crc32(veri, uzunluk)};
+        yazilan += dosya.write((const uint8_t *)&baslik, sizeof(baslik));
+    }
+    yazilan += dosya.write((const uint8_t *)veri, uzunluk);
+    dosya.close();
+
+    dosya_degisti(isim, (int32_t)yazilan - (int32_t)eskiBoyut);
+    return yazilan == uzunluk + (surum != 0 ? sizeof(depo_yapi_basligi) : 0);
+}
+
+/**
+ * @brief Sabit boyutlu kayıtlardan oluşan dosyada tek bir kaydı yazar (yaz_eleman).
+ *
+ * Dosya "r+" modunda açılır ve yalnızca ilgili bölge üzerine yazılır.
+ * Konum dosya sonundaysa kayıt sona eklenir; dosyanın ötesine yazılamaz.
+ *
+ * @param isim Dosya yolu
+ * @param konum Kaydın bayt konumu
+ * @param veri Yazılacak kayıt
+ * @param uzunluk Kayıt uzunluğu (bayt)
+ * @return true Başarılıysa true, aksi halde false
+ */
+bool dosya_sistemi::eleman_yaz(const char *isim, uint32_t konum, const void *veri, size_t uzunluk)
+{
+    yol_kilidi kilit(isim, true);
+    if (!kilit.tamam())
+        return false;
+    sabit_aktar(isim);
+    gunluk_isle(isim);
+    File dosya = _depo.open(isim, "r+");
+    if (!dosya && konum == 0)
+        dosya = _depo.open(isim, "w");
+    if (!dosya)
+        return false;
+
+    uint32_t eskiBoyut = dosya.size();
+    if (konum > eskiBoyut || !dosya.seek(konum, SeekSet))
+    {
+        dosya.close();
+        return false;
+    }
+    size_t yazilan = dosya.write((const uint8_t *)veri, uzunluk);
+    dosya.close();
+
+    dosya_degisti(isim, konum + yazilan > eskiBoyut ? konum + yazilan - eskiBoyut : 0);
+    return yazilan == uzunluk;
+}
+
+/**
+ * @brief Açık dosyanın içeriğini bellekteki veriyle blok blok karşılaştırır.
+ */
+static bool dosya_veriyle_ayni(File &dosya, const uint8_t *veri, size_t uzunluk)
+{
+    if (dosya.size() != uzunluk)
+        return false;
+    uint8_t tampon[DEPO_TAMPON];
+    size_t konum = 0;
+    while (konum < uzunluk)
+    {
+        size_t n = dosya.read(tampon, sizeof(tampon));
+        if (n == 0 || memcmp(tampon, veri + konum, n) != 0)
+            return false;
+        konum += n;
+    }
+    return true;
+}
+
+/**
+ * @brief Yazılmak istenen içerik flash'takiyle aynı mı kontrol eder.
+ *
+ * Önce `veri`nin CRC'si hesaplanır. Dosyanın son bilinen özeti tabloda varsa
+ * karar dosya okunmadan verilir. Yoksa dosya akış halinde `veri` ile
+ * karşılaştırılır; okumak flash'ı silip yeniden yazmaktan çok daha ucuzdur.
+ * Aynıysa istatistikler güncellenir ve true döner.
+ *
+ * @param isim Dosya yolu
+ * @param veri Yazılmak istenen içerik
+ * @param crc `veri`nin CRC-32 değeri (yazma sonrası ozet_kaydet için)
+ * @return true Yazma atlanabilir
+ */
+bool dosya_sistemi::icerik_ayni(const char *isim, const String &veri, uint32_t &crc)
+{
+    crc = crc32(veri.c_str(), veri.length());
+    gunluk_kaydi *g = gunluk_bul(isim);
+    if (g && g->kayitSayisi > 0)
+        return false; // flash'taki taban, günlük uygulanmış içerik değil
+    uint32_t ozet = yol_ozeti(isim);
+    bool ayni = false;
+    bool bulundu = false;
+
+    yol_kilidi::kritik_gir();
+    for (uint8_t i = 0; i < DEPO_OZET_SAYISI; i++)
+    {
+        if (_ozetler[i].yol == ozet)
+        {
+            bulundu = true;
+            ayni = _ozetler[i].boyut == veri.length() && _ozetler[i].crc == crc;
+            break;
+        }
+    }
+    yol_kilidi::kritik_cik();
+
+    if (!bulundu)
+    {
+        File dosya = _depo.open(isim, "r");
+        if (dosya && !dosya.isDirectory())
+        {
+            ayni = dosya_veriyle_ayni(dosya, (const uint8_t *)veri.c_str(), veri.length());
+            dosya.close();
+        }
+        if (ayni)
+            ozet_kaydet(isim, veri.length(), crc);
+    }
+
+    yol_kilidi::kritik_gir();
+    if (ayni)
+    {
+        _ozetIstatistik.atlanan++;
+        _ozetIstatistik.kazanilan_bayt += veri.length();
+        if (bulundu)
+            _ozetIstatistik.ozetten++;
+    }
+    else
+        _ozetIstatistik.yazilan++;
+    yol_kilidi::kritik_cik();
+    return ayni;
+}
+
+/**
+ * @brief Dosyanın flash'taki içeriğinin özetini tabloya kaydeder.
+ *
+ * Tablo doluysa en eski kaydın yerine yazılır.
+ */
+void dosya_sistemi::ozet_kaydet(const char *isim, uint32_t boyut, uint32_t crc)
+{
+    uint32_t ozet = yol_ozeti(isim);
+    yol_kilidi::kritik_gir();
+    uint8_t yer = DEPO_OZET_SAYISI;
+    for (uint8_t i = 0; i < DEPO_OZET_SAYISI; i++)
+    {
+        if (_ozetler[i].yol == ozet)
+        {
+            yer = i;
+            break;
+        }
+    }
+    if (yer == DEPO_OZET_SAYISI)
+    {
+        yer = _ozetSira;
+        _ozetSira = (_ozetSira + 1) % DEPO_OZET_SAYISI;
+    }
+    _ozetler[yer].yol = ozet;
+    _ozetler[yer].boyut = boyut;
+    _ozetler[yer].crc = crc;
+    yol_kilidi::kritik_cik();
+}
+
+/**
+ * @brief İçerik özeti tablosunu boşaltır.
+ *
+ * Dosyalar kütüphane dışından (doğrudan LittleFS ile) değiştirildiyse
+ * çağrılmalıdır; aksi halde yaz() eski özete bakarak yazmayı atlayabilir.
+ */
+void dosya_sistemi::ozetleri_temizle()
+{
+    yol_kilidi::kritik_gir();
+    for (uint8_t i = 0; i < DEPO_OZET_SAYISI; i++)
+        _ozetler[i].yol = 0;
+    yol_kilidi::kritik_cik();
+}
+
+/**
+ * @brief İki dosyanın içeriği aynı mı kontrol eder.
+ *
+ * Boyutlar farklıysa hiç okuma yapılmaz; aksi halde iki dosya
+ * blok blok karşılaştırılır.
+ */
+bool dosya_sistemi::dosyalar_ayni(const char *a, const char *b)
+{
+    File fa = _depo.open(a, "r");
+    File fb = _depo.open(b, "r");
+    bool ayni = fa && fb && !fa.isDirectory() && !fb.isDirectory() && fa.size() == fb.size();
+    uint8_t ta[DEPO_TAMPON / 2];
+    uint8_t tb[DEPO_TAMPON / 2];
+    while (ayni && fa.available())
+    {
+        size_t n = fa.read(ta, sizeof(ta));
+        ayni = n > 0 && fb.read(tb, n) == n && memcmp(ta, tb, n) == 0;
+    }
+    if (fa)
+        fa.close();
+    if (fb)
+        fb.close();
+    return ayni;
+}